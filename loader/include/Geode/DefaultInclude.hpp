@@ -205,7 +205,7 @@ namespace geode {
         if (strlen(message)) {                            \
             log::warn("[Forward Compat] " message);       \
         }                                                 \
-        for (const auto& [_, hook] : self.m_hooks) {      \
+        for (auto hook : self.getAllHooks()) {            \
             hook->setAutoEnable(false);                   \
         }                                                 \
     }
@@ -214,7 +214,7 @@ namespace geode {
         if (strlen(message)) {                            \
             log::warn("[Forward Compat] " message);       \
         }                                                 \
-        for (const auto& [_, hook] : self.m_hooks) {      \
+        for (auto hook : self.getAllHooks()) {            \
             hook->setAutoEnable(false);                   \
         }                                                 \
     }
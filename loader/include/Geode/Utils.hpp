@@ -10,5 +10,6 @@
 #include "utils/file.hpp"
 #include "utils/general.hpp"
 #include "utils/timer.hpp"
+#include "utils/thread.hpp"
 #include "utils/MiniFunction.hpp"
 #include "utils/ObjcHook.hpp"
@@ -64,18 +64,23 @@ namespace gd {
 	public:
 		string();
 		string(string const&);
-		// string(string&&);
+		string(string&&) noexcept;
 		string(char const*);
 		string(std::string const&);
-		// tried to add a string_view ctor, but got overload errors :(
+		string(std::string_view);
 		~string();
 
 		string& operator=(string const&);
-		string& operator=(string&&);
+		string& operator=(string&&) noexcept;
 		string& operator=(char const*);
 		string& operator=(std::string const&);
+		string& operator=(std::string_view);
 
 		void clear();
+		void reserve(size_t capacity);
+
+		string& append(std::string_view str);
+		string& operator+=(std::string_view str);
 		
 		char& at(size_t pos);
 		char const& at(size_t pos) const;
@@ -4,10 +4,88 @@
 #include "../utils/general.hpp"
 #include <matjson.hpp>
 #include "Tulip.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
 #include <string_view>
 #include <tulip/TulipHook.hpp>
 
+namespace geode::hook {
+    /**
+     * Call counters for a single instrumented detour. Only filled in for
+     * $modify hooks created while hook profiling is enabled
+     */
+    struct HookProfile {
+        std::atomic<uint64_t> calls = 0;
+        // Time spent in the detour, including other hooks it ended up calling
+        std::atomic<uint64_t> inclusiveNanoseconds = 0;
+        // Time spent in the detour itself
+        std::atomic<uint64_t> exclusiveNanoseconds = 0;
+    };
+
+    /**
+     * Whether hooks created right now should be instrumented. Controlled by
+     * the loader's "enable-hook-profiling" setting, and fixed for the session
+     */
+    GEODE_DLL bool isProfilingEnabled();
+
+    /**
+     * Associate a profile with a detour so it shows up in the runtime info
+     * of the hook using that detour
+     */
+    GEODE_DLL void registerProfile(void* detour, HookProfile* profile);
+
+    /**
+     * Get the profile registered for a detour
+     * @returns The profile, or nullptr if the detour isn't instrumented
+     */
+    GEODE_DLL HookProfile* getProfile(void* detour);
+
+    class ProfileScope;
+
+    /**
+     * Replace the innermost running profile scope on this thread, returning
+     * the previous one. Lives in the loader so nesting works across mods
+     */
+    GEODE_DLL ProfileScope* exchangeProfileScope(ProfileScope* scope);
+
+    /**
+     * Times a single call of an instrumented detour
+     */
+    class ProfileScope final {
+    private:
+        HookProfile* m_profile;
+        ProfileScope* m_parent;
+        uint64_t m_childNanoseconds = 0;
+        std::chrono::steady_clock::time_point m_start;
+
+    public:
+        explicit ProfileScope(HookProfile* profile) :
+            m_profile(profile),
+            m_parent(exchangeProfileScope(this)),
+            m_start(std::chrono::steady_clock::now()) {}
+
+        ~ProfileScope() {
+            uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - m_start
+            ).count();
+            exchangeProfileScope(m_parent);
+            if (m_parent) {
+                m_parent->m_childNanoseconds += elapsed;
+            }
+            m_profile->calls.fetch_add(1, std::memory_order_relaxed);
+            m_profile->inclusiveNanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+            m_profile->exclusiveNanoseconds.fetch_add(
+                elapsed - std::min(elapsed, m_childNanoseconds), std::memory_order_relaxed
+            );
+        }
+
+        ProfileScope(ProfileScope const&) = delete;
+        ProfileScope& operator=(ProfileScope const&) = delete;
+    };
+}
+
 namespace geode {
     class Mod;
     class Loader;
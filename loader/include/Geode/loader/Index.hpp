@@ -98,6 +98,28 @@ namespace geode {
         IndexUpdateFilter(IndexUpdateFilter const&) = default;
     };
 
+    /**
+     * Event broadcast on the main thread when the update statuses of the 
+     * installed mods have been recalculated, i.e. after the index has been 
+     * updated or a mod has been installed
+     */
+    struct GEODE_DLL IndexUpdateStatusEvent : public Event {
+        IndexUpdateStatusEvent();
+    };
+
+    /**
+     * Basic filter for listening to update status events. Always propagates 
+     * the event down the chain
+     */
+    class GEODE_DLL IndexUpdateStatusFilter : public EventFilter<IndexUpdateStatusEvent> {
+    public:
+        using Callback = void(IndexUpdateStatusEvent*);
+    
+        ListenerResult handle(utils::MiniFunction<Callback> fn, IndexUpdateStatusEvent* event);
+        IndexUpdateStatusFilter();
+        IndexUpdateStatusFilter(IndexUpdateStatusFilter const&) = default;
+    };
+
     class GEODE_DLL IndexItem final {
     public:
         class Impl;
@@ -141,6 +163,25 @@ namespace geode {
     };
     using IndexItemHandle = std::shared_ptr<IndexItem>;
 
+    /**
+     * How an installed mod compares to what is available on the index
+     */
+    struct ModUpdateStatus {
+        /**
+         * Newest item with the same major version as the installed mod that 
+         * is not older than it, or nullptr if there is none
+         */
+        IndexItemHandle latestCompatible;
+        /**
+         * Newest item of the mod regardless of major version
+         */
+        IndexItemHandle latestMajor;
+        /**
+         * Whether the newest item is newer than the installed mod
+         */
+        bool updateAvailable = false;
+    };
+
     struct IndexInstallList {
         /**
          * Mod being installed
@@ -256,6 +297,15 @@ namespace geode {
          * Check if any of the mods on the index have updates available
          */
         bool areUpdatesAvailable() const;
+        /**
+         * Get the update status of an installed mod. Statuses are calculated 
+         * once whenever the index is updated or a mod is installed; listen 
+         * for IndexUpdateStatusEvent to know when they change
+         * @param id ID of the installed mod
+         * @returns The status, or nothing if the mod isn't installed or 
+         * isn't on the index
+         */
+        std::optional<ModUpdateStatus> getUpdateStatus(std::string const& id) const;
         /**
          * Checks if the mod and its required dependencies can be installed
          * @param item Item to get the list for
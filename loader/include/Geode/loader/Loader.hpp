@@ -81,7 +81,23 @@ namespace geode {
         bool isModLoaded(std::string const& id) const;
         Mod* getLoadedMod(std::string const& id) const;
         std::vector<Mod*> getAllMods();
+        /**
+         * Get a copy of every problem, in the order they were found. Use 
+         * getProblemCount if only the amount is needed
+         */
         std::vector<LoadProblem> getProblems() const;
+        /**
+         * Get the problems caused by a specific mod
+         */
+        std::vector<LoadProblem> getProblems(Mod* mod) const;
+        /**
+         * Get the total amount of problems without copying them
+         */
+        size_t getProblemCount() const;
+        /**
+         * Get the amount of problems of a specific type without copying them
+         */
+        size_t getProblemCount(LoadProblem::Type type) const;
 
         void queueInMainThread(ScheduledFunction func);
 
@@ -266,6 +266,16 @@ namespace geode {
          */
         Result<Hook*> claimHook(std::shared_ptr<Hook> hook);
 
+        /**
+         * Claims multiple existing hook objects at once. Works the same as
+         * calling claimHook for each of them, but the mod's hook list (and
+         * the loader's list of hooks waiting to be enabled) only grows once.
+         * Hooks that fail to be claimed don't stop the rest from being claimed
+         * @returns Returns an error listing every hook that couldn't be claimed
+         * or enabled
+         */
+        Result<> claimHooks(std::vector<std::shared_ptr<Hook>> const& hooks);
+
         /**
          * Disowns a hook which this mod owns, making this mod no longer its owner.
          * If the hook has "auto enable" set, this will disable the hook.
@@ -4,6 +4,7 @@
 #include "Traits.hpp"
 
 #include <Geode/loader/Loader.hpp>
+#include <Geode/loader/Mod.hpp>
 #include <cocos2d.h>
 #include <vector>
 
@@ -17,6 +18,13 @@ namespace geode {
 }
 
 namespace geode::modifier {
+    /**
+     * Report memory allocated for a mod's fields, for per-mod memory
+     * usage. Does nothing unless memory tracking is enabled
+     */
+    GEODE_DLL void trackFieldAllocation(Mod* owner, void* field, size_t size);
+    GEODE_DLL void untrackFieldAllocation(void* field);
+
     class FieldContainer {
     private:
         std::vector<void*> m_containedFields;
@@ -26,6 +34,7 @@ namespace geode::modifier {
         ~FieldContainer() {
             for (auto i = 0u; i < m_containedFields.size(); i++) {
                 m_destructorFunctions[i](m_containedFields[i]);
+                untrackFieldAllocation(m_containedFields[i]);
                 operator delete(m_containedFields[i]);
             }
         }
@@ -38,9 +47,13 @@ namespace geode::modifier {
             return m_containedFields.at(index);
         }
 
-        void* setField(size_t index, size_t size, utils::MiniFunction<void(void*)> destructor) {
+        void* setField(
+            size_t index, size_t size, utils::MiniFunction<void(void*)> destructor,
+            Mod* owner = nullptr
+        ) {
             m_containedFields.at(index) = operator new(size);
             m_destructorFunctions.at(index) = destructor;
+            trackFieldAllocation(owner, m_containedFields.at(index), size);
             return m_containedFields.at(index);
         }
 
@@ -108,7 +121,8 @@ namespace geode::modifier {
             auto offsetField = container->getField(index);
             if (!offsetField) {
                 offsetField = container->setField(
-                    index, sizeof(Parent) - sizeof(Intermediate), &FieldIntermediate::fieldDestructor
+                    index, sizeof(Parent) - sizeof(Intermediate), &FieldIntermediate::fieldDestructor,
+                    Mod::get()
                 );
 
                 FieldIntermediate::fieldConstructor(offsetField);
@@ -6,6 +6,10 @@
 #include <Geode/loader/Loader.hpp>
 #include <Geode/loader/Mod.hpp>
 #include <iostream>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <tulip/TulipHook.hpp>
 
 #define GEODE_APPLY_MODIFY_FOR_FUNCTION(AddressInline_, Convention_, ClassName_, FunctionName_, ...) \
@@ -20,15 +24,13 @@
                 );                                                                                   \
                 break;                                                                               \
             }                                                                                        \
-            auto hook = Hook::create(                                                                \
-                reinterpret_cast<void*>(address),                                                    \
+            this->m_hookDescriptors.push_back(HookDescriptor::create<                                \
                 AsStaticFunction_##FunctionName_<                                                    \
                     Derived,                                                                         \
                     decltype(Resolve<__VA_ARGS__>::func(&Derived::FunctionName_))>::value,           \
-                #ClassName_ "::" #FunctionName_,                                                     \
-                tulip::hook::TulipConvention::Convention_                                            \
-            );                                                                                       \
-            this->m_hooks[#ClassName_ "::" #FunctionName_] = hook;                                   \
+                tulip::hook::TulipConvention::Convention_>(                                          \
+                reinterpret_cast<void*>(address), #ClassName_ "::" #FunctionName_                    \
+            ));                                                                                      \
         }                                                                                            \
     } while (0);
 
@@ -36,15 +38,13 @@
     do {                                                                                  \
         if constexpr (HasConstructor<Derived>) {                                          \
             static auto address = AddressInline_;                                         \
-            auto hook = Hook::create(                                                     \
-                reinterpret_cast<void*>(address),                                         \
+            this->m_hookDescriptors.push_back(HookDescriptor::create<                     \
                 AsStaticFunction_##constructor<                                           \
                     Derived,                                                              \
                     decltype(Resolve<__VA_ARGS__>::func(&Derived::constructor))>::value,  \
-                #ClassName_ "::" #ClassName_,                                             \
-                tulip::hook::TulipConvention::Convention_                                 \
-            );                                                                            \
-            this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                           \
+                tulip::hook::TulipConvention::Convention_>(                               \
+                reinterpret_cast<void*>(address), #ClassName_ "::" #ClassName_            \
+            ));                                                                           \
         }                                                                                 \
     } while (0);
 
@@ -52,13 +52,11 @@
     do {                                                                                                         \
         if constexpr (HasDestructor<Derived>) {                                                                  \
             static auto address = AddressInline_;                                                                \
-            auto hook = Hook::create(                                                                            \
-                reinterpret_cast<void*>(address),                                                                \
+            this->m_hookDescriptors.push_back(HookDescriptor::create<                                            \
                 AsStaticFunction_##destructor<Derived, decltype(Resolve<>::func(&Derived::destructor))>::value,  \
-                #ClassName_ "::" #ClassName_,                                                                    \
-                tulip::hook::TulipConvention::Convention_                                                        \
-            );                                                                                                   \
-            this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                                                  \
+                tulip::hook::TulipConvention::Convention_>(                                                      \
+                reinterpret_cast<void*>(address), #ClassName_ "::" #ClassName_                                   \
+            ));                                                                                                  \
         }                                                                                                        \
     } while (0);
 
@@ -67,46 +65,164 @@ namespace geode::modifier {
     template <class Derived, class Base>
     class ModifyDerive;
 
+    /**
+     * Everything needed to create a hook for a modified function, without
+     * actually creating it. The handler metadata (which allocates) is only
+     * built once the hook is created
+     */
+    struct HookDescriptor {
+        void* address;
+        void* detour;
+        char const* name;
+        tulip::hook::HandlerMetadata (*handlerMetadata)();
+        // used in place of detour when hook profiling is enabled
+        void* profiledDetour;
+        hook::HookProfile* profile;
+
+        template <auto Detour, class = decltype(Detour)>
+        struct Profiled {};
+
+        template <auto Detour, class Return, class... Params>
+        struct Profiled<Detour, Return (*)(Params...)> {
+            static inline hook::HookProfile profile;
+
+            static Return GEODE_CDECL_CALL function(Params... params) {
+                hook::ProfileScope scope(&profile);
+                return Detour(std::forward<Params>(params)...);
+            }
+        };
+
+        template <auto Detour, tulip::hook::TulipConvention Convention>
+        static tulip::hook::HandlerMetadata handlerMetadataFor() {
+            return tulip::hook::HandlerMetadata{
+                .m_convention = geode::hook::createConvention(Convention),
+                .m_abstract = tulip::hook::AbstractFunction::from(Detour)
+            };
+        }
+
+        template <auto Detour, tulip::hook::TulipConvention Convention>
+        static HookDescriptor create(void* address, char const* name) {
+            return HookDescriptor{
+                address,
+                reinterpret_cast<void*>(Detour),
+                name,
+                &HookDescriptor::handlerMetadataFor<Detour, Convention>,
+                reinterpret_cast<void*>(&Profiled<Detour>::function),
+                &Profiled<Detour>::profile
+            };
+        }
+
+        std::shared_ptr<Hook> createHook() const {
+            // the wrapper has the same signature, so the handler metadata is shared
+            if (hook::isProfilingEnabled()) {
+                hook::registerProfile(profiledDetour, profile);
+                return Hook::create(
+                    address, profiledDetour, name, handlerMetadata(), tulip::hook::HookMetadata()
+                );
+            }
+            return Hook::create(address, detour, name, handlerMetadata(), tulip::hook::HookMetadata());
+        }
+    };
+
     template <class ModifyDerived>
     class ModifyBase {
     public:
-        std::map<std::string, std::shared_ptr<Hook>> m_hooks;
+        std::vector<HookDescriptor> m_hookDescriptors;
+        // hooks in the same order as their descriptors, only created once
+        // something asks for them (or when they're claimed). mutable because
+        // onModify usually only gets a const reference
+        mutable std::vector<std::shared_ptr<Hook>> m_hooks;
+        // overloads share a name, so a name can map to several slots
+        mutable std::unordered_multimap<std::string_view, size_t> m_hookIndices;
+
+        Hook* getHookAt(size_t index) const {
+            if (m_hooks.size() < m_hookDescriptors.size()) {
+                m_hooks.resize(m_hookDescriptors.size());
+            }
+            auto& hook = m_hooks[index];
+            if (!hook) {
+                hook = m_hookDescriptors[index].createHook();
+            }
+            return hook.get();
+        }
+
+        /**
+         * Get every hook with this name, which is more than one if the
+         * function is overloaded
+         */
+        std::vector<Hook*> getHooks(std::string_view name) const {
+            // most modify classes never look up their hooks, so
+            // only build the name index once someone does
+            if (m_hookIndices.empty()) {
+                m_hookIndices.reserve(m_hookDescriptors.size());
+                for (size_t i = 0; i < m_hookDescriptors.size(); i++) {
+                    m_hookIndices.emplace(m_hookDescriptors[i].name, i);
+                }
+            }
+            std::vector<Hook*> hooks;
+            auto [begin, end] = m_hookIndices.equal_range(name);
+            for (auto it = begin; it != end; ++it) {
+                hooks.push_back(this->getHookAt(it->second));
+            }
+            return hooks;
+        }
+
+        /**
+         * Get every hook in this modify
+         */
+        std::vector<Hook*> getAllHooks() const {
+            std::vector<Hook*> hooks;
+            hooks.reserve(m_hookDescriptors.size());
+            for (size_t i = 0; i < m_hookDescriptors.size(); i++) {
+                hooks.push_back(this->getHookAt(i));
+            }
+            return hooks;
+        }
 
-        Result<Hook*> getHook(std::string const& name) {
-            if (m_hooks.find(name) == m_hooks.end()) {
+        Result<Hook*> getHook(std::string_view name) const {
+            auto hooks = this->getHooks(name);
+            if (hooks.empty()) {
                 return Err("Hook not in this modify");
             }
-            return Ok(m_hooks[name].get());
+            return Ok(hooks.front());
         }
 
-        Result<> setHookPriority(std::string const& name, int32_t priority) {
-            auto res = this->getHook(name);
-            if (!res) {
-                return Err(res.unwrapErr());
+        Result<> setHookPriority(std::string_view name, int32_t priority) const {
+            auto hooks = this->getHooks(name);
+            if (hooks.empty()) {
+                return Err("Hook not in this modify");
+            }
+            for (auto hook : hooks) {
+                hook->setPriority(priority);
             }
-            res.unwrap()->setPriority(priority);
             return Ok();
         }
 
-        // unordered_map<handles> idea
         ModifyBase() {
             // i really dont want to recompile codegen
             auto test = static_cast<ModifyDerived*>(this);
             test->ModifyDerived::apply();
             ModifyDerived::Derived::onModify(*this);
-            std::vector<std::string> added;
-            for (auto& [uuid, hook] : m_hooks) {
-                auto res = Mod::get()->claimHook(hook);
-                if (!res) {
-                    log::error("Failed to claim hook {}: {}", hook->getDisplayName(), res.error());
+
+            std::vector<std::shared_ptr<Hook>> hooks;
+            hooks.reserve(m_hookDescriptors.size());
+            for (size_t i = 0; i < m_hookDescriptors.size(); i++) {
+                if (i < m_hooks.size() && m_hooks[i]) {
+                    hooks.push_back(std::move(m_hooks[i]));
                 }
                 else {
-                    added.push_back(uuid);
+                    hooks.push_back(m_hookDescriptors[i].createHook());
                 }
             }
-            for (auto& uuid : added) {
-                m_hooks.erase(uuid);
+            auto res = Mod::get()->claimHooks(hooks);
+            if (!res) {
+                log::error("Failed to claim hooks: {}", res.unwrapErr());
             }
+
+            // everything is owned by the mod now
+            m_hookDescriptors = {};
+            m_hooks = {};
+            m_hookIndices = {};
         }
 
         virtual void apply() {}
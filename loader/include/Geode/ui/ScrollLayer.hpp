@@ -2,6 +2,7 @@
 
 #include <Geode/binding/CCContentLayer.hpp>
 #include <Geode/binding/CCScrollLayerExt.hpp>
+#include <vector>
 
 namespace geode {
     /**
@@ -10,10 +11,43 @@ namespace geode {
      * a generic content layer
      */
     class GEODE_DLL GenericContentLayer : public CCContentLayer {
+    protected:
+        struct CulledChild {
+            cocos2d::CCNode* node;
+            float y;
+            float height;
+        };
+
+        // children sorted by their Y position, used to only update
+        // the visibility of children near the visible area when scrolling
+        std::vector<CulledChild> m_culledChildren;
+        float m_maxChildHeight = 0.f;
+        size_t m_visibleBegin = 0;
+        size_t m_visibleEnd = 0;
+        bool m_childOrderDirty = true;
+
+        void rebuildChildOrder();
+        void updateVisibleChildren();
+
     public:
         static GenericContentLayer* create(float width, float height);
 
         void setPosition(cocos2d::CCPoint const& pos) override;
+
+        using CCContentLayer::addChild;
+        using CCContentLayer::removeChild;
+        void addChild(cocos2d::CCNode* child, int zOrder, int tag) override;
+        void removeChild(cocos2d::CCNode* child, bool cleanup) override;
+        void removeAllChildrenWithCleanup(bool cleanup) override;
+
+        /**
+         * Mark the cached order of children as outdated, so it is rebuilt
+         * on the next scroll. Children that are added, removed, laid out
+         * through updateLayout, moved or resized are picked up
+         * automatically, so this is only needed if a child's position or
+         * size is written to directly
+         */
+        void invalidateChildOrder();
     };
 
     class GEODE_DLL ScrollLayer : public CCScrollLayerExt {
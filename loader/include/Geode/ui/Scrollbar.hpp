@@ -15,6 +15,14 @@ namespace geode {
         bool m_hoverHighlight;
         bool m_touchDown = false;
 
+        // target geometry the track and thumb were last laid out for, so
+        // they are only touched when the target scrolls or resizes
+        bool m_geometryDirty = true;
+        float m_lastTargetHeight = 0.f;
+        float m_lastContentHeight = 0.f;
+        float m_lastScrollLimitTop = 0.f;
+        float m_lastScrollPos = 0.f;
+
         bool ccTouchBegan(cocos2d::CCTouch* touch, cocos2d::CCEvent* event) override;
         void ccTouchMoved(cocos2d::CCTouch* touch, cocos2d::CCEvent* event) override;
         void ccTouchEnded(cocos2d::CCTouch* touch, cocos2d::CCEvent* event) override;
@@ -22,7 +30,10 @@ namespace geode {
         void scrollWheel(float y, float x) override;
         void registerWithTouchDispatcher() override;
 
-        void draw() override;
+        void update(float dt) override;
+        void updateTrack(float targetHeight);
+        void updateThumb(float targetHeight, float contentHeight);
+        void updateThumbColor();
 
         bool init(CCScrollLayerExt* list);
 
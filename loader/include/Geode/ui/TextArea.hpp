@@ -63,11 +63,14 @@ namespace geode {
 
         bool m_shouldUpdate;
         bool m_artificialWidth;
+        // every label created so far, reused across relayouts
+        std::vector<cocos2d::CCLabelBMFont*> m_labelPool;
 
         SimpleTextArea(const std::string& font, const std::string& text, const float scale, const float width, const bool artificialWidth);
-        cocos2d::CCLabelBMFont* createLabel(const std::string& text, const float top);
-        float calculateOffset(cocos2d::CCLabelBMFont* label);
-        void charIteration(const std::function<cocos2d::CCLabelBMFont*(cocos2d::CCLabelBMFont* line, const char c, const float top)>& overflowHandling);
+        cocos2d::CCLabelBMFont* reuseLabel(const size_t index, const std::string& text, const float top);
+        float calculateOffset(const std::string& line);
+        void updateLabels(const std::vector<std::string>& lines, const std::vector<float>& tops);
+        void charIteration(const std::function<std::string(std::string& line, const char c)>& overflowHandling);
         void updateLinesNoWrap();
         void updateLinesWordWrap();
         void updateLinesCutoffWrap();
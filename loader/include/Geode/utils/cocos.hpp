@@ -7,6 +7,7 @@
 #include <cocos2d.h>
 #include <functional>
 #include <type_traits>
+#include <unordered_map>
 #include "../loader/Event.hpp"
 #include "MiniFunction.hpp"
 
@@ -682,6 +683,17 @@ namespace geode::cocos {
      */
     GEODE_DLL void reloadTextures(CreateLayerFunc returnTo = nullptr);
 
+    /**
+     * Change the search paths (for example by adding or removing a texture 
+     * pack) and reload only the textures and sprite sheets whose files now 
+     * resolve to a different path. Textures and sprite frames are updated 
+     * in place, so sprites in the running scene change without rebuilding 
+     * it and without the loading screen reloadTextures goes through
+     * @param changeSearchPaths Function that changes the search paths
+     * @returns The number of textures and sprite sheets reloaded
+     */
+    GEODE_DLL size_t reloadChangedTextures(utils::MiniFunction<void()> const& changeSearchPaths);
+
     /**
      * Rescale node to fit inside given size
      * @param node Node to rescale
@@ -1117,6 +1129,38 @@ namespace geode::cocos {
         }
     };
 
+    /**
+     * Assigns touch priorities to whole node trees at once. Handlers are 
+     * looked up through a map built once from the touch dispatcher, and the 
+     * dispatcher's handler lists are only re-sorted once, when the batch is 
+     * applied or destroyed, instead of after every changed priority
+     */
+    class GEODE_DLL TouchPriorityBatch final {
+        std::unordered_map<cocos2d::CCTouchDelegate*, cocos2d::CCTouchHandler*> m_handlers;
+        bool m_changed = false;
+
+    public:
+        TouchPriorityBatch();
+        TouchPriorityBatch(TouchPriorityBatch const&) = delete;
+        TouchPriorityBatch& operator=(TouchPriorityBatch const&) = delete;
+        ~TouchPriorityBatch();
+
+        /**
+         * Get the touch handler registered for a node, if it is a touch 
+         * delegate
+         */
+        cocos2d::CCTouchHandler* findHandler(cocos2d::CCNode* node) const;
+        /**
+         * Queue the same priorities handleTouchPriorityWith would set for 
+         * the children of node
+         */
+        void assign(cocos2d::CCNode* node, int priority, bool force = false);
+        /**
+         * Re-sort the dispatcher's handlers if any priority changed
+         */
+        void apply();
+    };
+
     void GEODE_DLL handleTouchPriorityWith(cocos2d::CCNode* node, int priority, bool force = false);
     void GEODE_DLL handleTouchPriority(cocos2d::CCNode* node, bool force = false);
 }
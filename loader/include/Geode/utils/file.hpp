@@ -2,11 +2,13 @@
 
 #include "Result.hpp"
 #include "general.hpp"
+#include "thread.hpp"
 #include "../loader/Event.hpp"
 
 #include <matjson.hpp>
 #include <Geode/DefaultInclude.hpp>
 #include <ghc/fs_fwd.hpp>
+#include <span>
 #include <string>
 #include <unordered_set>
 
@@ -28,6 +30,36 @@ namespace geode::utils::file {
     GEODE_DLL Result<matjson::Value> readJson(ghc::filesystem::path const& path);
     GEODE_DLL Result<ByteVector> readBinary(ghc::filesystem::path const& path);
 
+    /**
+     * A read-only view of a file mapped into memory, for large files that 
+     * don't need to be copied into a buffer. The data stays valid for as 
+     * long as the MappedFile is alive
+     */
+    class GEODE_DLL MappedFile final {
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_impl;
+
+        MappedFile(std::unique_ptr<Impl>&& impl);
+
+    public:
+        MappedFile(MappedFile const&) = delete;
+        MappedFile(MappedFile&& other);
+        ~MappedFile();
+
+        /**
+         * Map a file into memory
+         */
+        static Result<MappedFile> create(ghc::filesystem::path const& path);
+
+        /**
+         * Pointer to the file's contents, or nullptr if the file is empty
+         */
+        uint8_t const* data() const;
+        size_t size() const;
+        std::string_view view() const;
+    };
+
     template <class T>
     Result<T> readFromJson(ghc::filesystem::path const& file) {
         GEODE_UNWRAP_INTO(auto json, readJson(file));
@@ -51,9 +83,29 @@ namespace geode::utils::file {
     GEODE_DLL Result<std::vector<ghc::filesystem::path>> readDirectory(
         ghc::filesystem::path const& path, bool recursive = false
     );
+    /**
+     * Call a function for every entry in a directory as it is read, without 
+     * collecting them first. The entries' types come from the directory 
+     * listing itself, so checking `is_directory()` etc. doesn't need to stat 
+     * the file again on most file systems
+     * @param path Directory to iterate
+     * @param callback Function called with every entry
+     * @param recursive Whether to iterate subdirectories too
+     */
+    GEODE_DLL Result<> iterateDirectory(
+        ghc::filesystem::path const& path,
+        utils::MiniFunction<void(ghc::filesystem::directory_entry const&)> callback,
+        bool recursive = false
+    );
 
     class Unzip;
 
+    /**
+     * Unzip progress callback, receives the number of entries done and the 
+     * total. Return false to stop
+     */
+    using UnzipProgress = utils::MiniFunction<bool(size_t, size_t)>;
+
     class GEODE_DLL Zip final {
     public:
         using Path = ghc::filesystem::path;
@@ -99,6 +151,22 @@ namespace geode::utils::file {
          */
         ByteVector getData() const;
 
+        /**
+         * Set the deflate level used for entries added after this call, from 
+         * 0 (store uncompressed) to 9 (smallest output). Defaults to zlib's 
+         * default level. Entries that don't shrink are always stored as-is
+         */
+        void setCompressionLevel(int level);
+        /**
+         * Set how many threads may be used to deflate entries. Files added 
+         * through Zip::addAllFrom are compressed concurrently and large 
+         * entries are split into blocks that are compressed concurrently; 
+         * either way entries are written to the zip in the order they were 
+         * added. Pass 0 to use one thread per core. Defaults to 1, which 
+         * compresses everything on the calling thread
+         */
+        void setThreadCount(size_t count);
+
         /**
          * Add an entry to the zip with data
          */
@@ -172,10 +240,19 @@ namespace geode::utils::file {
         bool hasEntry(Path const& name);
 
         /**
-         * Extract entry to memory
+         * Extract entry to memory. Zips are normally read straight from a 
+         * memory mapping of the file, in which case this can be called from 
+         * several threads at once
          * @param name Entry path in zip
          */
         Result<ByteVector> extract(Path const& name);
+        /**
+         * Get an uncompressed entry's data without copying it. Fails for 
+         * compressed entries, and for zips that couldn't be memory mapped. 
+         * The data is valid for as long as the Unzip is alive
+         * @param name Entry path in zip
+         */
+        Result<std::span<uint8_t const>> view(Path const& name) const;
         /**
          * Extract entry to file
          * @param name Entry path in zip
@@ -187,6 +264,14 @@ namespace geode::utils::file {
          * @param dir Directory to unzip the contents to
          */
         Result<> extractAllTo(Path const& dir);
+        /**
+         * Extract all entries to directory
+         * @param dir Directory to unzip the contents to
+         * @param progress Called before each entry with the number of 
+         * entries extracted so far and the total, and once more with both 
+         * equal when done. Returning false stops extracting
+         */
+        Result<> extractAllTo(Path const& dir, UnzipProgress const& progress);
 
         /**
          * Helper method for quickly unzipping a file
@@ -200,6 +285,20 @@ namespace geode::utils::file {
             Path const& to,
             bool deleteZipAfter = false
         );
+        /**
+         * Helper method for quickly unzipping a file
+         * @param from ZIP file to unzip
+         * @param to Directory to unzip to
+         * @param deleteZipAfter Whether to delete the zip after unzipping
+         * @param progress Progress callback, see extractAllTo
+         * @returns Succesful result on success, errorful result on error
+         */
+        static Result<> intoDir(
+            Path const& from,
+            Path const& to,
+            bool deleteZipAfter,
+            UnzipProgress const& progress
+        );
     };
 
     /**
@@ -296,4 +395,89 @@ namespace geode::utils::file {
      * @param file The file to unwatch
      */
     GEODE_DLL void unwatchFile(ghc::filesystem::path const& file);
+
+    /**
+     * Non-blocking versions of the file utilities. The work runs on the 
+     * I/O thread pool and the callbacks are called on the main thread. 
+     * Every function returns the task doing the work; cancelling it before 
+     * it finishes means the callback is never called. The work is 
+     * attributed to the calling mod in thread::getStats
+     */
+    namespace async {
+        template <class T = geode::impl::DefaultValue>
+        using Callback = utils::MiniFunction<void(Result<T> const&)>;
+        template <class T = geode::impl::DefaultValue>
+        using Task = thread::Task<Result<T>>;
+        /**
+         * Progress callback, receives the amount of work done and the total
+         */
+        using Progress = utils::MiniFunction<void(size_t, size_t)>;
+
+        GEODE_DLL Task<std::string> readString(
+            ghc::filesystem::path const& path,
+            Callback<std::string> callback = {},
+            Mod* mod = getMod()
+        );
+        GEODE_DLL Task<matjson::Value> readJson(
+            ghc::filesystem::path const& path,
+            Callback<matjson::Value> callback = {},
+            Mod* mod = getMod()
+        );
+        GEODE_DLL Task<ByteVector> readBinary(
+            ghc::filesystem::path const& path,
+            Callback<ByteVector> callback = {},
+            Mod* mod = getMod()
+        );
+
+        /**
+         * Write a file atomically: the data is written to a temporary file 
+         * next to the target, which is then renamed over it. Writes to the 
+         * same path are done in the order they were requested, and writes 
+         * that are still queued are coalesced, so only the newest data gets 
+         * written and every coalesced call gets the same result. Each call 
+         * gets its own task: cancelling it only drops that call's data and 
+         * callback, and the write is skipped if every call was cancelled
+         */
+        GEODE_DLL Task<> writeString(
+            ghc::filesystem::path const& path,
+            std::string const& data,
+            Callback<> callback = {},
+            Mod* mod = getMod()
+        );
+        /**
+         * Write a file atomically, see writeString
+         */
+        GEODE_DLL Task<> writeBinary(
+            ghc::filesystem::path const& path,
+            ByteVector data,
+            Callback<> callback = {},
+            Mod* mod = getMod()
+        );
+
+        GEODE_DLL Task<std::vector<ghc::filesystem::path>> readDirectory(
+            ghc::filesystem::path const& path,
+            bool recursive = false,
+            Callback<std::vector<ghc::filesystem::path>> callback = {},
+            Mod* mod = getMod()
+        );
+
+        /**
+         * Unzip a file into a directory
+         * @param from ZIP file to unzip
+         * @param to Directory to unzip to
+         * @param deleteZipAfter Whether to delete the zip after unzipping
+         * @param callback Called on the main thread when done
+         * @param progress Called on the main thread with the number of 
+         * entries extracted and the total, at most once per percent and 
+         * always once the last entry is done
+         */
+        GEODE_DLL Task<> unzip(
+            ghc::filesystem::path const& from,
+            ghc::filesystem::path const& to,
+            bool deleteZipAfter = false,
+            Callback<> callback = {},
+            Progress progress = {},
+            Mod* mod = getMod()
+        );
+    }
 }
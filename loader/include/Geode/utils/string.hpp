@@ -3,6 +3,8 @@
 #include <Geode/DefaultInclude.hpp>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <iterator>
 #include <vector>
 
 namespace geode::utils::string {
@@ -19,55 +21,155 @@ namespace geode::utils::string {
      */
     GEODE_DLL std::wstring utf8ToWide(std::string const& str);
 
+    /**
+     * Lowercase a string in-place. Only ASCII characters are converted,
+     * so UTF-8 sequences are left untouched
+     */
     GEODE_DLL std::string& toLowerIP(std::string& str);
     GEODE_DLL std::wstring& toLowerIP(std::wstring& str);
 
-    GEODE_DLL std::string toLower(std::string const& str);
-    GEODE_DLL std::wstring toLower(std::wstring const& str);
+    GEODE_DLL std::string toLower(std::string_view str);
+    GEODE_DLL std::wstring toLower(std::wstring_view str);
 
+    /**
+     * Uppercase a string in-place. Only ASCII characters are converted,
+     * so UTF-8 sequences are left untouched
+     */
     GEODE_DLL std::string& toUpperIP(std::string& str);
     GEODE_DLL std::wstring& toUpperIP(std::wstring& str);
 
-    GEODE_DLL std::string toUpper(std::string const& str);
-    GEODE_DLL std::wstring toUpper(std::wstring const& str);
+    GEODE_DLL std::string toUpper(std::string_view str);
+    GEODE_DLL std::wstring toUpper(std::wstring_view str);
 
+    /**
+     * Replace all occurrences of orig with repl. The result is built in a
+     * single pass, so replacing many occurrences stays linear. An empty
+     * orig leaves the string unchanged
+     */
     GEODE_DLL std::string& replaceIP(
-        std::string& str, std::string const& orig, std::string const& repl
+        std::string& str, std::string_view orig, std::string_view repl
     );
     GEODE_DLL std::wstring& replaceIP(
-        std::wstring& str, std::wstring const& orig, std::wstring const& repl
+        std::wstring& str, std::wstring_view orig, std::wstring_view repl
     );
 
     GEODE_DLL std::string replace(
-        std::string const& str, std::string const& orig, std::string const& repl
+        std::string_view str, std::string_view orig, std::string_view repl
     );
     GEODE_DLL std::wstring replace(
-        std::wstring const& str, std::wstring const& orig, std::wstring const& repl
+        std::wstring_view str, std::wstring_view orig, std::wstring_view repl
     );
 
-    GEODE_DLL std::vector<std::string> split(std::string const& str, std::string const& split);
-    GEODE_DLL std::vector<std::wstring> split(std::wstring const& str, std::wstring const& split);
-
-    GEODE_DLL std::string join(std::vector<std::string> const& strs, std::string const& separator);
-    GEODE_DLL std::wstring join(std::vector<std::wstring> const& strs, std::wstring const& separator);
-
-    GEODE_DLL std::vector<char> split(std::string const& str);
-    GEODE_DLL std::vector<wchar_t> split(std::wstring const& str);
-
-    GEODE_DLL bool contains(std::string const& str, std::string const& subs);
-    GEODE_DLL bool contains(std::wstring const& str, std::wstring const& subs);
+    /**
+     * A lazy range over the parts of a string separated by a separator.
+     * Yields views into the original string, which must outlive the range.
+     * Matches the behaviour of split: an empty string yields nothing, and
+     * an empty separator yields the whole string
+     */
+    template <class Char>
+    class BasicSplitView {
+        using View = std::basic_string_view<Char>;
+
+        View m_str;
+        View m_separator;
+
+    public:
+        class Iterator {
+            View m_str;
+            View m_separator;
+            size_t m_begin = View::npos;
+            size_t m_end = View::npos;
+
+            void findEnd() {
+                m_end = m_separator.empty() ? View::npos : m_str.find(m_separator, m_begin);
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = View;
+            using difference_type = std::ptrdiff_t;
+            using pointer = View const*;
+            using reference = View;
+
+            Iterator() = default;
+            Iterator(View str, View separator)
+              : m_str(str), m_separator(separator), m_begin(str.empty() ? View::npos : 0) {
+                if (m_begin != View::npos) this->findEnd();
+            }
+
+            View operator*() const {
+                return m_str.substr(m_begin, m_end == View::npos ? View::npos : m_end - m_begin);
+            }
+
+            Iterator& operator++() {
+                if (m_end == View::npos) {
+                    m_begin = View::npos;
+                }
+                else {
+                    m_begin = m_end + m_separator.size();
+                    this->findEnd();
+                }
+                return *this;
+            }
+            Iterator operator++(int) {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(Iterator const& other) const {
+                return m_begin == other.m_begin;
+            }
+        };
+
+        BasicSplitView(View str, View separator) : m_str(str), m_separator(separator) {}
+
+        Iterator begin() const {
+            return Iterator(m_str, m_separator);
+        }
+        Iterator end() const {
+            return Iterator();
+        }
+    };
+
+    using SplitView = BasicSplitView<char>;
+    using WideSplitView = BasicSplitView<wchar_t>;
+
+    inline SplitView splitView(std::string_view str, std::string_view separator) {
+        return SplitView(str, separator);
+    }
+    inline WideSplitView splitView(std::wstring_view str, std::wstring_view separator) {
+        return WideSplitView(str, separator);
+    }
+
+    GEODE_DLL std::vector<std::string> split(std::string_view str, std::string_view split);
+    GEODE_DLL std::vector<std::wstring> split(std::wstring_view str, std::wstring_view split);
+
+    GEODE_DLL std::string join(std::vector<std::string> const& strs, std::string_view separator);
+    GEODE_DLL std::wstring join(std::vector<std::wstring> const& strs, std::wstring_view separator);
+
+    GEODE_DLL std::vector<char> split(std::string_view str);
+    GEODE_DLL std::vector<wchar_t> split(std::wstring_view str);
+
+    GEODE_DLL bool contains(std::string_view str, std::string_view subs);
+    GEODE_DLL bool contains(std::wstring_view str, std::wstring_view subs);
+
+    GEODE_DLL bool contains(std::string_view str, char c);
+    GEODE_DLL bool contains(std::wstring_view str, wchar_t c);
 
-    GEODE_DLL bool contains(std::string const& str, char c);
-    GEODE_DLL bool contains(std::wstring const& str, wchar_t c);
+    /**
+     * Check if a string contains a substring, ignoring ASCII case
+     */
+    GEODE_DLL bool containsIgnoreCase(std::string_view str, std::string_view subs);
 
-    GEODE_DLL bool containsAny(std::string const& str, std::vector<std::string> const& subs);
-    GEODE_DLL bool containsAny(std::wstring const& str, std::vector<std::wstring> const& subs);
+    GEODE_DLL bool containsAny(std::string_view str, std::vector<std::string> const& subs);
+    GEODE_DLL bool containsAny(std::wstring_view str, std::vector<std::wstring> const& subs);
 
-    GEODE_DLL bool containsAll(std::string const& str, std::vector<std::string> const& subs);
-    GEODE_DLL bool containsAll(std::wstring const& str, std::vector<std::wstring> const& subs);
+    GEODE_DLL bool containsAll(std::string_view str, std::vector<std::string> const& subs);
+    GEODE_DLL bool containsAll(std::wstring_view str, std::vector<std::wstring> const& subs);
 
-    GEODE_DLL size_t count(std::string const& str, char c);
-    GEODE_DLL size_t count(std::wstring const& str, wchar_t c);
+    GEODE_DLL size_t count(std::string_view str, char c);
+    GEODE_DLL size_t count(std::wstring_view str, wchar_t c);
 
     GEODE_DLL std::string& trimLeftIP(std::string& str);
     GEODE_DLL std::wstring& trimLeftIP(std::wstring& str);
@@ -76,20 +178,20 @@ namespace geode::utils::string {
     GEODE_DLL std::string& trimIP(std::string& str);
     GEODE_DLL std::wstring& trimIP(std::wstring& str);
 
-    GEODE_DLL std::string trimLeft(std::string const& str);
-    GEODE_DLL std::wstring trimLeft(std::wstring const& str);
-    GEODE_DLL std::string trimRight(std::string const& str);
-    GEODE_DLL std::wstring trimRight(std::wstring const& str);
-    GEODE_DLL std::string trim(std::string const& str);
-    GEODE_DLL std::wstring trim(std::wstring const& str);
+    GEODE_DLL std::string trimLeft(std::string_view str);
+    GEODE_DLL std::wstring trimLeft(std::wstring_view str);
+    GEODE_DLL std::string trimRight(std::string_view str);
+    GEODE_DLL std::wstring trimRight(std::wstring_view str);
+    GEODE_DLL std::string trim(std::string_view str);
+    GEODE_DLL std::wstring trim(std::wstring_view str);
 
     GEODE_DLL std::string& normalizeIP(std::string& str);
     GEODE_DLL std::wstring& normalizeIP(std::wstring& str);
-    GEODE_DLL std::string normalize(std::string const& str);
-    GEODE_DLL std::wstring normalize(std::wstring const& str);
+    GEODE_DLL std::string normalize(std::string_view str);
+    GEODE_DLL std::wstring normalize(std::wstring_view str);
 
-    GEODE_DLL bool startsWith(std::string const& str, std::string const& prefix);
-    GEODE_DLL bool startsWith(std::wstring const& str, std::wstring const& prefix);
-    GEODE_DLL bool endsWith(std::string const& str, std::string const& suffix);
-    GEODE_DLL bool endsWith(std::wstring const& str, std::wstring const& suffix);
+    GEODE_DLL bool startsWith(std::string_view str, std::string_view prefix);
+    GEODE_DLL bool startsWith(std::wstring_view str, std::wstring_view prefix);
+    GEODE_DLL bool endsWith(std::string_view str, std::string_view suffix);
+    GEODE_DLL bool endsWith(std::wstring_view str, std::wstring_view suffix);
 }
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "MiniFunction.hpp"
+
+#include <Geode/DefaultInclude.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace geode {
+    class Mod;
+
+    Mod* getMod();
+}
+
+namespace geode::utils::thread {
+    /**
+     * Where a task or continuation should run
+     */
+    enum class RunOn {
+        /**
+         * On one of the workers of the shared pool
+         */
+        Pool,
+        /**
+         * On the main (cocos) thread, through Loader::queueInMainThread
+         */
+        MainThread,
+        /**
+         * On a separate, small pool for work that blocks on disk or other 
+         * I/O, so it doesn't hold up the workers of the shared pool
+         */
+        IO,
+    };
+
+    /**
+     * Task counts for a single mod
+     */
+    struct TaskStats {
+        size_t queued = 0;
+        size_t running = 0;
+        size_t completed = 0;
+        size_t cancelled = 0;
+    };
+
+    namespace impl {
+        class GEODE_DLL TaskStateBase {
+        protected:
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::vector<MiniFunction<void()>> m_continuations;
+            std::exception_ptr m_exception;
+            std::atomic<bool> m_cancelled = false;
+            bool m_done = false;
+
+            // marks the task finished and runs its continuations
+            void finish(std::unique_lock<std::mutex>& lock);
+
+        public:
+            Mod* const mod;
+
+            TaskStateBase(Mod* mod) : mod(mod) {}
+            virtual ~TaskStateBase() = default;
+
+            bool isCancelled() const;
+            bool isDone();
+            void cancel();
+            void fail(std::exception_ptr exception);
+            void wait();
+            void rethrow();
+            // runs func immediately if the task is already done
+            void onDone(MiniFunction<void()> func);
+        };
+
+        template <class T>
+        using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        template <class T>
+        class TaskState final : public TaskStateBase {
+            std::optional<Stored<T>> m_value;
+
+        public:
+            using TaskStateBase::TaskStateBase;
+
+            void resolve(Stored<T>&& value) {
+                std::unique_lock lock(m_mutex);
+                if (m_done) return;
+                m_value.emplace(std::move(value));
+                this->finish(lock);
+            }
+
+            Stored<T>* value() {
+                std::unique_lock lock(m_mutex);
+                return m_value ? &m_value.value() : nullptr;
+            }
+        };
+
+        template <class F, class T>
+        struct ContinuationResult : std::invoke_result<F, T const&> {};
+
+        template <class F>
+        struct ContinuationResult<F, void> : std::invoke_result<F> {};
+
+        /**
+         * Queue a job that belongs to the given task. The job is skipped if
+         * the task is cancelled before it starts
+         */
+        GEODE_DLL void post(
+            std::shared_ptr<TaskStateBase> state, RunOn target, MiniFunction<void()> job
+        );
+
+        template <class T, class F, class... Args>
+        void invokeInto(std::shared_ptr<TaskState<T>> const& state, F& func, Args&&... args) {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    func(std::forward<Args>(args)...);
+                    state->resolve(std::monostate());
+                }
+                else {
+                    state->resolve(func(std::forward<Args>(args)...));
+                }
+            }
+            catch (...) {
+                state->fail(std::current_exception());
+            }
+        }
+    }
+
+    /**
+     * Handle to a unit of work running on the shared pool. Copies of a Task
+     * refer to the same work
+     */
+    template <class T>
+    class Task final {
+        std::shared_ptr<impl::TaskState<T>> m_state;
+
+        template <class>
+        friend class Task;
+
+        Task(std::shared_ptr<impl::TaskState<T>> state) : m_state(std::move(state)) {}
+
+    public:
+        using Value = T;
+
+        /**
+         * Create a task that runs func on the given target
+         * @param func Function returning the task's value
+         * @param target Where to run func
+         * @param mod Mod the task is attributed to
+         */
+        template <class F>
+        static Task run(F func, RunOn target, Mod* mod) {
+            auto state = std::make_shared<impl::TaskState<T>>(mod);
+            impl::post(state, target, [state, func]() mutable {
+                impl::invokeInto<T>(state, func);
+            });
+            return Task(std::move(state));
+        }
+
+        /**
+         * Whether the task has finished, failed or been cancelled
+         */
+        bool isFinished() const {
+            return m_state->isDone();
+        }
+
+        /**
+         * Whether cancel() was called on this task or the task it continues
+         */
+        bool isCancelled() const {
+            return m_state->isCancelled();
+        }
+
+        /**
+         * Cancel the task. If it hasn't started yet it will never run, and
+         * its continuations are cancelled as well. Work that is already
+         * running can poll geode::utils::thread::isCancelled() to stop early
+         */
+        void cancel() {
+            m_state->cancel();
+        }
+
+        /**
+         * Mod this task is attributed to
+         */
+        Mod* getMod() const {
+            return m_state->mod;
+        }
+
+        /**
+         * Block until the task is done and get its value. Rethrows anything
+         * the task threw. Returns nullptr if the task was cancelled
+         * @warning Do not wait on a task from the main thread if it has a
+         * continuation on the main thread, and avoid waiting on pool tasks
+         * from inside another pool task
+         */
+        impl::Stored<T>* wait() {
+            m_state->wait();
+            m_state->rethrow();
+            return m_state->value();
+        }
+
+        /**
+         * Get the value of the task if it has finished successfully
+         */
+        impl::Stored<T>* getValue() const {
+            return m_state->value();
+        }
+
+        /**
+         * Run func with the value of this task once it finishes. If this
+         * task fails or is cancelled, the returned task is cancelled
+         * @param func Continuation; takes T const& (or nothing if T is void)
+         * @param target Where to run the continuation
+         */
+        template <class F>
+        auto then(F func, RunOn target = RunOn::Pool) {
+            using R = typename impl::ContinuationResult<F, T>::type;
+            auto next = std::make_shared<impl::TaskState<R>>(m_state->mod);
+            auto prev = m_state;
+            m_state->onDone([prev, next, func, target]() {
+                auto value = prev->value();
+                if (!value || prev->isCancelled()) {
+                    next->cancel();
+                    return;
+                }
+                impl::post(next, target, [prev, next, func]() mutable {
+                    if constexpr (std::is_void_v<T>) {
+                        impl::invokeInto<R>(next, func);
+                    }
+                    else {
+                        impl::invokeInto<R>(next, func, std::as_const(*prev->value()));
+                    }
+                });
+            });
+            return Task<R>(std::move(next));
+        }
+    };
+
+    /**
+     * Run func asynchronously on the shared pool, attributed to the calling
+     * mod
+     * @param func Function to run. Its return value becomes the value of
+     * the task
+     * @param target Where to run the function
+     */
+    template <class F>
+    auto async(F func, RunOn target = RunOn::Pool) {
+        return Task<std::invoke_result_t<F>>::run(std::move(func), target, geode::getMod());
+    }
+
+    /**
+     * Whether the task the current thread is running has been cancelled.
+     * Always false outside of tasks
+     */
+    GEODE_DLL bool isCancelled();
+
+    /**
+     * Number of worker threads in the shared pool
+     */
+    GEODE_DLL size_t getWorkerCount();
+
+    /**
+     * Whether the calling thread is a worker of the shared pool
+     */
+    GEODE_DLL bool isWorkerThread();
+
+    /**
+     * Get the task counts for a mod
+     */
+    GEODE_DLL TaskStats getStats(Mod* mod);
+}
@@ -59,6 +59,15 @@ namespace geode::utils::web {
     using AsyncExpect = utils::MiniFunction<void(std::string const&)>;
     using AsyncExpectCode = utils::MiniFunction<void(std::string const&, int)>;
     using AsyncThen = utils::MiniFunction<void(SentAsyncWebRequest&, ByteVector const&)>;
+    /**
+     * Delivers an already converted response, run on the GD thread
+     */
+    using AsyncDeliver = utils::MiniFunction<void(SentAsyncWebRequest&)>;
+    /**
+     * Converts a response on the request's own thread, so the GD thread
+     * only has to deliver the result
+     */
+    using AsyncConvert = utils::MiniFunction<AsyncDeliver(ByteVector const&)>;
     using AsyncCancelled = utils::MiniFunction<void(SentAsyncWebRequest&)>;
 
     /**
@@ -126,6 +135,7 @@ namespace geode::utils::web {
         friend class SentAsyncWebRequest::Impl;
 
         AsyncWebRequest& setThen(AsyncThen);
+        AsyncWebRequest& setConvert(AsyncConvert);
     public:
         /**
          * An asynchronous, thread-safe web request. Downloads data from the
@@ -315,7 +325,10 @@ namespace geode::utils::web {
         /**
          * Download into a file
          * @param path File to download into. If it already exists, it will
-         * be overwritten.
+         * be overwritten once the download finishes. Until then the data is
+         * kept in a `.part` file next to it, and if the server sent an ETag
+         * or Last-Modified validator, a failed or cancelled download is
+         * resumed from there by the next request for the same URL
          * @returns AsyncWebResult, where you can specify the `then` action for
          * after the download is finished. The result has a `std::monostate`
          * template parameter, as it can be assumed you know what you passed
@@ -356,31 +369,37 @@ namespace geode::utils::web {
         }
     };
 
+    // the converters run on the request's thread, and only
+    // the converted value gets handed over to the GD thread
     template <class T>
     AsyncWebRequest& AsyncWebResult<T>::then(utils::MiniFunction<void(T)> handle) {
-        return m_request.setThen([converter = m_converter,
-                            handle](SentAsyncWebRequest& req, ByteVector const& arr) {
+        return m_request.setConvert([converter = m_converter, handle](ByteVector const& arr) -> AsyncDeliver {
             auto conv = converter(arr);
-            if (conv) {
-                handle(conv.unwrap());
-            }
-            else {
-                req.error("Unable to convert value: " + conv.unwrapErr(), -1);
+            if (!conv) {
+                return [error = "Unable to convert value: " + conv.unwrapErr()](SentAsyncWebRequest& req) {
+                    req.error(error, -1);
+                };
             }
+            auto value = std::make_shared<T>(std::move(conv).unwrap());
+            return [handle, value](SentAsyncWebRequest&) {
+                handle(std::move(*value));
+            };
         });
     }
 
     template <class T>
     AsyncWebRequest& AsyncWebResult<T>::then(utils::MiniFunction<void(SentAsyncWebRequest&, T)> handle) {
-        return m_request.setThen([converter = m_converter,
-                            handle](SentAsyncWebRequest& req, ByteVector const& arr) {
+        return m_request.setConvert([converter = m_converter, handle](ByteVector const& arr) -> AsyncDeliver {
             auto conv = converter(arr);
-            if (conv) {
-                handle(req, conv.value());
-            }
-            else {
-                req.error("Unable to convert value: " + conv.error(), -1);
+            if (!conv) {
+                return [error = "Unable to convert value: " + conv.unwrapErr()](SentAsyncWebRequest& req) {
+                    req.error(error, -1);
+                };
             }
+            auto value = std::make_shared<T>(std::move(conv).unwrap());
+            return [handle, value](SentAsyncWebRequest& req) {
+                handle(req, std::move(*value));
+            };
         });
     }
 }
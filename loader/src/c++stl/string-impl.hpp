@@ -12,9 +12,18 @@ namespace geode::stl {
         // frees the existing string
         void free();
 
+        // steals the storage of other, leaving it empty.
+        // assumes the existing data is already freed
+        void moveFrom(StringData& other);
+
         char* getStorage();
         void setStorage(const std::string_view);
 
+        // makes sure the storage is uniquely owned and can hold
+        // at least the given amount of chars (not counting the null terminator),
+        // keeping the current contents
+        void reserve(size_t);
+
         size_t getSize();
         void setSize(size_t);
 
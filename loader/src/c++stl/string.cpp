@@ -3,6 +3,8 @@
 #include <string_view>
 #include <string>
 #include <compare>
+#include <algorithm>
+#include <cstring>
 
 template <class Type>
 Type& intoMutRef(const Type& x) {
@@ -24,12 +26,9 @@ namespace gd {
         impl.setStorage(str);
     }
 
-    // string::string(string&& other) {
-    //     // TODO: do this better :-)
-    //     impl.setStorage(other);
-    //     implFor(other).free();
-    //     implFor(other).setEmpty();
-    // }
+    string::string(string&& other) noexcept {
+        impl.moveFrom(other.m_data);
+    }
 
     string::string(char const* str) {
         impl.setStorage(str);
@@ -39,6 +38,10 @@ namespace gd {
         impl.setStorage(str);
     }
 
+    string::string(std::string_view str) {
+        impl.setStorage(str);
+    }
+
     string::~string() {
         this->clear();
     }
@@ -50,12 +53,11 @@ namespace gd {
         }
         return *this;
     }
-    string& string::operator=(string&& other) {
-        // TODO: do this better :-)
-        impl.free();
-        impl.setStorage(other);
-        implFor(other).free();
-        implFor(other).setEmpty();
+    string& string::operator=(string&& other) noexcept {
+        if (this != &other) {
+            impl.free();
+            impl.moveFrom(other.m_data);
+        }
         return *this;
     }
     string& string::operator=(char const* other) {
@@ -68,11 +70,50 @@ namespace gd {
         impl.setStorage(other);
         return *this;
     }
+    string& string::operator=(std::string_view other) {
+        // other may point into our own storage
+        if (other.data() >= this->data() && other.data() < this->data() + this->size()) {
+            return *this = std::string(other);
+        }
+        impl.free();
+        impl.setStorage(other);
+        return *this;
+    }
 
     void string::clear() {
         impl.free();
         impl.setEmpty();
     }
+
+    void string::reserve(size_t capacity) {
+        impl.reserve(capacity);
+    }
+
+    string& string::append(std::string_view str) {
+        if (str.empty()) return *this;
+
+        auto const size = this->size();
+        auto const capacity = this->capacity();
+        auto const newSize = size + str.size();
+
+        // str may point into our own storage, which reserve could reallocate
+        bool const aliased = str.data() >= this->data() && str.data() < this->data() + size;
+        auto const aliasOffset = aliased ? str.data() - this->data() : 0;
+
+        // grow geometrically so repeated appends stay amortized O(1)
+        impl.reserve(newSize > capacity ? std::max(newSize, capacity * 2) : capacity);
+        if (aliased) {
+            str = std::string_view(this->data() + aliasOffset, str.size());
+        }
+
+        std::memcpy(impl.getStorage() + size, str.data(), str.size());
+        impl.getStorage()[newSize] = 0;
+        impl.setSize(newSize);
+        return *this;
+    }
+    string& string::operator+=(std::string_view str) {
+        return this->append(str);
+    }
     
     char& string::at(size_t pos) {
         if (pos >= this->size())
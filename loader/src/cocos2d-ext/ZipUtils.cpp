@@ -34,8 +34,19 @@
 #include <Geode/c++stl/gdstdlib.hpp>
 #include <assert.h>
 #include <ccMacros.h>
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdio.h>
 #include <stdlib.h>
+#include <vector>
+
+#ifdef GEODE_USE_LIBDEFLATE
+    #include <libdeflate.h>
+#endif
 
 NS_CC_BEGIN
 
@@ -141,6 +152,51 @@ inline unsigned int ZipUtils::ccChecksumPvr(unsigned int const* data, int len) {
 // Should buffer factor be 1.5 instead of 2 ?
 #define BUFFER_INC_FACTOR (2)
 
+// deflate can't compress better than about 1032:1, so anything claiming
+// more than that is corrupted and shouldn't be used to size buffers
+#define MAX_DEFLATE_RATIO (1032)
+
+// gzip stores the uncompressed size (mod 2^32) in its last 4 bytes
+static unsigned int gzipSizeFromTrailer(unsigned char const* trailer, unsigned long compressedSize) {
+    unsigned int size = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) |
+        (static_cast<unsigned int>(trailer[3]) << 24);
+    if (static_cast<unsigned long long>(size) > static_cast<unsigned long long>(compressedSize) * MAX_DEFLATE_RATIO) {
+        return 0;
+    }
+    return size;
+}
+
+static unsigned int gzipSizeHint(unsigned char const* in, unsigned int inLength) {
+    // 10 byte header + 8 byte trailer
+    if (inLength < 18 || in[0] != 0x1f || in[1] != 0x8b) {
+        return 0;
+    }
+    return gzipSizeFromTrailer(in + inLength - 4, inLength);
+}
+
+#ifdef GEODE_USE_LIBDEFLATE
+static libdeflate_decompressor* getDecompressor() {
+    static thread_local std::unique_ptr<libdeflate_decompressor, void (*)(libdeflate_decompressor*)>
+        decompressor(libdeflate_alloc_decompressor(), &libdeflate_free_decompressor);
+    return decompressor.get();
+}
+
+// decompresses a single member gzip stream whose exact size is known,
+// returns false if the data needs to go through zlib instead
+static bool gzipDecompressExact(
+    unsigned char const* in, unsigned int inLength, unsigned char* out, unsigned int outLength
+) {
+    auto decompressor = getDecompressor();
+    if (!decompressor) return false;
+    size_t actualIn = 0;
+    size_t actualOut = 0;
+    auto res = libdeflate_gzip_decompress_ex(
+        decompressor, in, inLength, out, outLength, &actualIn, &actualOut
+    );
+    return res == LIBDEFLATE_SUCCESS && actualIn == inLength && actualOut == outLength;
+}
+#endif
+
 int ZipUtils::ccInflateMemoryWithHint(
     unsigned char* in, unsigned int inLength, unsigned char** out, unsigned int* outLength,
     unsigned int outLenghtHint
@@ -148,7 +204,23 @@ int ZipUtils::ccInflateMemoryWithHint(
     /* ret value */
     int err = Z_OK;
 
-    int bufferSize = outLenghtHint;
+    // gzip tells us exactly how big the output is going to be
+    unsigned int exactSize = gzipSizeHint(in, inLength);
+
+#ifdef GEODE_USE_LIBDEFLATE
+    if (exactSize) {
+        *out = new unsigned char[exactSize];
+        if (gzipDecompressExact(in, inLength, *out, exactSize)) {
+            *outLength = exactSize;
+            return Z_OK;
+        }
+        delete[] *out;
+    }
+#endif
+
+    // one extra byte so a correct size hint lets inflate
+    // finish without having to grow the buffer
+    unsigned int bufferSize = exactSize ? exactSize + 1 : std::max(outLenghtHint, 1u);
     *out = new unsigned char[bufferSize];
 
     z_stream d_stream; /* decompression stream */
@@ -177,21 +249,29 @@ int ZipUtils::ccInflateMemoryWithHint(
             case Z_MEM_ERROR: inflateEnd(&d_stream); return err;
         }
 
-        // not enough memory ?
-        if (err != Z_STREAM_END) {
-            *out = (unsigned char*)realloc(*out, bufferSize * BUFFER_INC_FACTOR);
-
-            /* not enough memory, ouch */
-            if (!*out) {
-                CCLOG("cocos2d: ZipUtils: realloc failed");
-                inflateEnd(&d_stream);
-                return Z_MEM_ERROR;
-            }
+        // ran out of input before the stream ended
+        if (d_stream.avail_out != 0) {
+            inflateEnd(&d_stream);
+            return Z_DATA_ERROR;
+        }
 
-            d_stream.next_out = *out + bufferSize;
-            d_stream.avail_out = bufferSize;
-            bufferSize *= BUFFER_INC_FACTOR;
+        // not enough memory ?
+        // the buffer came from new[], so it can't be realloc'd
+        auto grown = new (std::nothrow) unsigned char[bufferSize * BUFFER_INC_FACTOR];
+
+        /* not enough memory, ouch */
+        if (!grown) {
+            CCLOG("cocos2d: ZipUtils: realloc failed");
+            inflateEnd(&d_stream);
+            return Z_MEM_ERROR;
         }
+        std::memcpy(grown, *out, bufferSize);
+        delete[] *out;
+        *out = grown;
+
+        d_stream.next_out = *out + bufferSize;
+        d_stream.avail_out = bufferSize * (BUFFER_INC_FACTOR - 1);
+        bufferSize *= BUFFER_INC_FACTOR;
     }
 
     *outLength = bufferSize - d_stream.avail_out;
@@ -232,6 +312,24 @@ int ZipUtils::ccInflateMemory(unsigned char* in, unsigned int inLength, unsigned
     return ccInflateMemoryWithHint(in, inLength, out, 256 * 1024);
 }
 
+// reads the size stored in the gzip trailer of a file, or 0 if unknown
+static unsigned int gzipFileSizeHint(char const* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    unsigned int size = 0;
+    unsigned char trailer[4];
+    if (fseek(file, -4, SEEK_END) == 0) {
+        long compressedSize = ftell(file) + 4;
+        if (compressedSize >= 18 && fread(trailer, 1, sizeof(trailer), file) == sizeof(trailer)) {
+            size = gzipSizeFromTrailer(trailer, compressedSize);
+        }
+    }
+    fclose(file);
+    return size;
+}
+
 int ZipUtils::ccInflateGZipFile(char const* path, unsigned char** out) {
     int len;
     unsigned int offset = 0;
@@ -239,49 +337,69 @@ int ZipUtils::ccInflateGZipFile(char const* path, unsigned char** out) {
     CCAssert(out, "");
     CCAssert(&*out, "");
 
+    unsigned int exactSize = gzipFileSizeHint(path);
+
+#ifdef GEODE_USE_LIBDEFLATE
+    if (exactSize) {
+        unsigned long compressedSize = 0;
+        auto compressed = CCFileUtils::sharedFileUtils()->getFileData(path, "rb", &compressedSize);
+        if (compressed) {
+            *out = (unsigned char*)malloc(exactSize);
+            bool ok = *out && gzipDecompressExact(compressed, compressedSize, *out, exactSize);
+            delete[] compressed;
+            if (ok) {
+                return exactSize;
+            }
+            free(*out);
+            *out = NULL;
+        }
+    }
+#endif
+
     gzFile inFile = gzopen(path, "rb");
     if (inFile == NULL) {
         CCLOG("cocos2d: ZipUtils: error open gzip file: %s", path);
         return -1;
     }
+    // the default 8k internal buffer means a lot of tiny reads
+    gzbuffer(inFile, 128 * 1024);
 
-    /* 512k initial decompress buffer */
-    unsigned int bufferSize = 512 * 1024;
-    unsigned int totalBufferSize = bufferSize;
+    /* 512k initial decompress buffer, unless the trailer told us the size */
+    /* (one extra byte so reading the whole thing is seen as reaching the end) */
+    unsigned int totalBufferSize = exactSize ? exactSize + 1 : 512 * 1024;
 
-    *out = (unsigned char*)malloc(bufferSize);
-    if (!out) {
+    *out = (unsigned char*)malloc(totalBufferSize);
+    if (!*out) {
         CCLOG("cocos2d: ZipUtils: out of memory");
+        gzclose(inFile);
         return -1;
     }
 
     for (;;) {
-        len = gzread(inFile, *out + offset, bufferSize);
+        len = gzread(inFile, *out + offset, totalBufferSize - offset);
         if (len < 0) {
             CCLOG("cocos2d: ZipUtils: error in gzread");
             free(*out);
             *out = NULL;
+            gzclose(inFile);
             return -1;
         }
-        if (len == 0) {
-            break;
-        }
 
         offset += len;
 
         // finish reading the file
-        if ((unsigned int)len < bufferSize) {
+        if (offset < totalBufferSize) {
             break;
         }
 
-        bufferSize *= BUFFER_INC_FACTOR;
-        totalBufferSize += bufferSize;
+        totalBufferSize *= BUFFER_INC_FACTOR;
         unsigned char* tmp = (unsigned char*)realloc(*out, totalBufferSize);
 
         if (!tmp) {
             CCLOG("cocos2d: ZipUtils: out of memory");
             free(*out);
             *out = NULL;
+            gzclose(inFile);
             return -1;
         }
 
@@ -382,9 +500,23 @@ int ZipUtils::ccInflateCCZFile(char const* path, unsigned char** out) {
         return -1;
     }
 
-    unsigned long destlen = len;
-    unsigned long source = (unsigned long)compressed + sizeof(*header);
-    int ret = uncompress(*out, &destlen, (Bytef*)source, fileLen - sizeof(*header));
+    auto source = compressed + sizeof(*header);
+    auto sourceLen = fileLen - sizeof(*header);
+
+#ifdef GEODE_USE_LIBDEFLATE
+    if (auto decompressor = getDecompressor()) {
+        size_t actualOut = 0;
+        auto res = libdeflate_zlib_decompress(decompressor, source, sourceLen, *out, len, &actualOut);
+        if (res == LIBDEFLATE_SUCCESS && actualOut == len) {
+            delete[] compressed;
+            return len;
+        }
+    }
+#endif
+
+    // the header tells us the exact size, so this is always a single allocation
+    uLongf destlen = len;
+    int ret = uncompress(*out, &destlen, (Bytef*)source, sourceLen);
 
     delete[] compressed;
 
@@ -429,17 +561,58 @@ struct ZipEntryInfo {
 class ZipFilePrivate {
 public:
     unzFile zipFile;
+    std::string path;
 
     // std::unordered_map is faster if available on the platform
     typedef std::map<std::string, struct ZipEntryInfo> FileListContainer;
     FileListContainer fileList;
+
+    // minizip handles have a single cursor, so every concurrent read
+    // borrows its own handle to the same archive. file positions are
+    // the same across handles, so fileList can be shared. the mutex
+    // guards fileList as well, since setFilter can replace it
+    std::mutex handlesMutex;
+    std::vector<unzFile> freeHandles;
+    std::vector<unzFile> extraHandles;
+
+    unzFile acquireHandle() {
+        {
+            std::lock_guard lock(handlesMutex);
+            if (!freeHandles.empty()) {
+                auto handle = freeHandles.back();
+                freeHandles.pop_back();
+                return handle;
+            }
+        }
+        auto handle = unzOpen(path.c_str());
+        if (handle) {
+            std::lock_guard lock(handlesMutex);
+            extraHandles.push_back(handle);
+        }
+        return handle;
+    }
+
+    void releaseHandle(unzFile handle) {
+        std::lock_guard lock(handlesMutex);
+        freeHandles.push_back(handle);
+    }
+
+    ~ZipFilePrivate() {
+        for (auto handle : extraHandles) {
+            unzClose(handle);
+        }
+    }
 };
 
 ZipFile::ZipFile(std::string const& zipFile, std::string const& filter) :
     _data(new ZipFilePrivate), _dataThread(new ZipFilePrivate) {
+    _data->path = zipFile;
+    _dataThread->path = zipFile;
     _data->zipFile = unzOpen(zipFile.c_str());
     _dataThread->zipFile = unzOpen(zipFile.c_str());
     if (_data->zipFile && _dataThread->zipFile) {
+        _data->freeHandles.push_back(_data->zipFile);
+        _dataThread->freeHandles.push_back(_dataThread->zipFile);
         setFilter(filter);
     }
 }
@@ -461,8 +634,11 @@ bool ZipFile::setFilter(std::string const& filter, ZipFilePrivate* data) {
         CC_BREAK_IF(!data);
         CC_BREAK_IF(!data->zipFile);
 
-        // clear existing file list
-        data->fileList.clear();
+        // the cursor of data->zipFile may be in use by a reader
+        unzFile handle = data->acquireHandle();
+        CC_BREAK_IF(!handle);
+
+        ZipFilePrivate::FileListContainer fileList;
 
         // UNZ_MAXFILENAMEINZIP + 1 - it is done so in unzLocateFile
         char szCurrentFileName[UNZ_MAXFILENAMEINZIP + 1];
@@ -470,11 +646,11 @@ bool ZipFile::setFilter(std::string const& filter, ZipFilePrivate* data) {
 
         // go through all files and store position information about the required files
         int err = unzGoToFirstFile64(
-            data->zipFile, &fileInfo, szCurrentFileName, sizeof(szCurrentFileName) - 1
+            handle, &fileInfo, szCurrentFileName, sizeof(szCurrentFileName) - 1
         );
         while (err == UNZ_OK) {
             unz_file_pos posInfo;
-            int posErr = unzGetFilePos(data->zipFile, &posInfo);
+            int posErr = unzGetFilePos(handle, &posInfo);
             if (posErr == UNZ_OK) {
                 std::string currentFileName = szCurrentFileName;
                 // cache info about filtered files only (like 'assets/')
@@ -482,14 +658,20 @@ bool ZipFile::setFilter(std::string const& filter, ZipFilePrivate* data) {
                     ZipEntryInfo entry;
                     entry.pos = posInfo;
                     entry.uncompressed_size = (uLong)fileInfo.uncompressed_size;
-                    data->fileList[currentFileName] = entry;
+                    fileList[currentFileName] = entry;
                 }
             }
             // next file - also get the information about it
             err = unzGoToNextFile64(
-                data->zipFile, &fileInfo, szCurrentFileName, sizeof(szCurrentFileName) - 1
+                handle, &fileInfo, szCurrentFileName, sizeof(szCurrentFileName) - 1
             );
         }
+        data->releaseHandle(handle);
+
+        {
+            std::lock_guard lock(data->handlesMutex);
+            data->fileList = std::move(fileList);
+        }
         ret = true;
 
     } while (false);
@@ -506,6 +688,7 @@ bool ZipFile::fileExists(std::string const& fileName) const {
     do {
         CC_BREAK_IF(!_data);
 
+        std::lock_guard lock(_data->handlesMutex);
         ret = _data->fileList.find(fileName) != _data->fileList.end();
     } while (false);
 
@@ -528,26 +711,39 @@ unsigned char* ZipFile::getFileData(
         CC_BREAK_IF(!data->zipFile);
         CC_BREAK_IF(fileName.empty());
 
-        ZipFilePrivate::FileListContainer::const_iterator it = data->fileList.find(fileName);
-        CC_BREAK_IF(it == data->fileList.end());
-
-        ZipEntryInfo fileInfo = it->second;
+        ZipEntryInfo fileInfo;
+        {
+            std::lock_guard lock(data->handlesMutex);
+            ZipFilePrivate::FileListContainer::const_iterator it = data->fileList.find(fileName);
+            if (it == data->fileList.end()) {
+                break;
+            }
+            fileInfo = it->second;
+        }
 
-        int nRet = unzGoToFilePos(data->zipFile, &fileInfo.pos);
-        CC_BREAK_IF(UNZ_OK != nRet);
+        unzFile handle = data->acquireHandle();
+        CC_BREAK_IF(!handle);
 
-        nRet = unzOpenCurrentFile(data->zipFile);
-        CC_BREAK_IF(UNZ_OK != nRet);
+        int nRet = unzGoToFilePos(handle, &fileInfo.pos);
+        if (UNZ_OK == nRet) {
+            nRet = unzOpenCurrentFile(handle);
+        }
+        if (UNZ_OK != nRet) {
+            data->releaseHandle(handle);
+            break;
+        }
 
+        // the central directory gives us the exact size up front
         pBuffer = new unsigned char[fileInfo.uncompressed_size];
         int CC_UNUSED nSize =
-            unzReadCurrentFile(data->zipFile, pBuffer, fileInfo.uncompressed_size);
+            unzReadCurrentFile(handle, pBuffer, fileInfo.uncompressed_size);
         CCAssert(nSize == 0 || nSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
 
         if (pSize) {
             *pSize = fileInfo.uncompressed_size;
         }
-        unzCloseCurrentFile(data->zipFile);
+        unzCloseCurrentFile(handle);
+        data->releaseHandle(handle);
     } while (0);
 
     return pBuffer;
@@ -559,6 +755,7 @@ bool ZipFile::isLoaded() const {
 
 std::vector<std::string> ZipFile::getAllFiles() const {
     std::vector<std::string> res;
+    std::lock_guard lock(_data->handlesMutex);
     for (auto [key, _] : _data->fileList) {
         res.push_back(key);
     }
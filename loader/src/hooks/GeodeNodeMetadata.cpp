@@ -2,6 +2,8 @@
 #include <Geode/utils/cocos.hpp>
 #include <Geode/modify/Field.hpp>
 #include <Geode/modify/CCNode.hpp>
+#include <Geode/ui/ScrollLayer.hpp>
+#include <AllocationTracker.hpp>
 #include <cocos2d.h>
 
 using namespace geode::prelude;
@@ -28,9 +30,17 @@ private:
     friend class ProxyCCNode;
     friend class cocos2d::CCNode;
 
-    GeodeNodeMetadata() : m_fieldContainer(new FieldContainer()) {}
+    GeodeNodeMetadata() : m_fieldContainer(new FieldContainer()) {
+        // the metadata is allocated by the loader on behalf of every node
+        if (auto tracker = getModAllocationTracker()) {
+            tracker->allocated(Mod::get(), this, sizeof(GeodeNodeMetadata) + sizeof(FieldContainer));
+        }
+    }
 
     virtual ~GeodeNodeMetadata() {
+        if (auto tracker = getModAllocationTracker()) {
+            tracker->freed(this);
+        }
         delete m_fieldContainer;
     }
 
@@ -82,6 +92,28 @@ struct ProxyCCNode : Modify<ProxyCCNode, CCNode> {
         }
         m_pUserObject = obj;
     }
+
+    // GenericContentLayer keeps its children sorted by Y for culling, so it
+    // has to hear about children moving or resizing. the cast is only done
+    // when something it cares about actually changed
+    void setPosition(CCPoint const& pos) {
+        auto moved = pos.y != m_obPosition.y;
+        CCNode::setPosition(pos);
+        if (moved && m_pParent) {
+            if (auto content = typeinfo_cast<GenericContentLayer*>(m_pParent)) {
+                content->invalidateChildOrder();
+            }
+        }
+    }
+    void setContentSize(CCSize const& size) {
+        auto resized = size.height != m_obContentSize.height;
+        CCNode::setContentSize(size);
+        if (resized && m_pParent) {
+            if (auto content = typeinfo_cast<GenericContentLayer*>(m_pParent)) {
+                content->invalidateChildOrder();
+            }
+        }
+    }
 };
 
 static inline std::unordered_map<std::string, size_t> s_nextIndex;
@@ -89,6 +121,18 @@ size_t modifier::getFieldIndexForClass(char const* name) {
 	return s_nextIndex[name]++;
 }
 
+void modifier::trackFieldAllocation(Mod* owner, void* field, size_t size) {
+    if (auto tracker = getModAllocationTracker()) {
+        tracker->allocated(owner, field, size);
+    }
+}
+
+void modifier::untrackFieldAllocation(void* field) {
+    if (auto tracker = getModAllocationTracker()) {
+        tracker->freed(field);
+    }
+}
+
 // not const because might modify contents
 FieldContainer* CCNode::getFieldContainer() {
     return GeodeNodeMetadata::set(this)->getFieldContainer();
@@ -163,6 +207,10 @@ void CCNode::updateLayout(bool updateChildOrder) {
     }
     if (auto layout = GeodeNodeMetadata::set(this)->m_layout.data()) {
         layout->apply(this);
+        // the layout probably moved the children around
+        if (auto content = typeinfo_cast<GenericContentLayer*>(this)) {
+            content->invalidateChildOrder();
+        }
     }
 }
 
@@ -126,8 +126,15 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     void setupModResources() {
         log::debug("Loading mod resources");
         this->setSmallText("Loading mod resources");
-        LoaderImpl::get()->updateResources(true);
-        this->continueLoadAssets();
+        LoaderImpl::get()->updateResourcesAsync(
+            true,
+            [this](size_t decoded, size_t total) {
+                this->setSmallText(fmt::format("Loading mod resources: {}/{}", decoded, total));
+            },
+            [this]() {
+                this->continueLoadAssets();
+            }
+        );
     }
     
     int getCurrentStep() {
@@ -0,0 +1,124 @@
+#include "AllocationTracker.hpp"
+
+#include <cmath>
+#include <random>
+#include <thread>
+
+AllocationTracker::AllocationTracker(size_t sampleInterval)
+  : m_sampleInterval(sampleInterval) {}
+
+size_t AllocationTracker::getSampleInterval() const {
+    return m_sampleInterval;
+}
+
+std::atomic_uint32_t& AllocationTracker::bucketFor(void const* ptr) {
+    // allocations are aligned, so the low bits carry no information
+    auto hash = (reinterpret_cast<uintptr_t>(ptr) >> 4) * 0x9e3779b97f4a7c15ull;
+    return m_sampledBuckets[(hash >> 32) % m_sampledBuckets.size()];
+}
+
+bool AllocationTracker::shouldSample(size_t size) {
+    if (m_sampleInterval == 0) {
+        return true;
+    }
+    // samples are a poisson process over allocated bytes, so the distance
+    // to the next sample is exponentially distributed. the countdown is
+    // per thread so the common case touches no shared state
+    thread_local std::minstd_rand rng(
+        static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id()))
+    );
+    thread_local double untilNextSample = -1;
+
+    auto draw = [&]() {
+        std::exponential_distribution<double> dist(1.0 / m_sampleInterval);
+        return dist(rng);
+    };
+    if (untilNextSample < 0) {
+        untilNextSample = draw();
+    }
+    untilNextSample -= static_cast<double>(size);
+    if (untilNextSample > 0) {
+        return false;
+    }
+    untilNextSample = draw();
+    return true;
+}
+
+void AllocationTracker::allocated(void const* owner, void const* ptr, size_t size) {
+    if (!ptr || !this->shouldSample(size)) {
+        return;
+    }
+
+    // an allocation of this size had this chance of being picked,
+    // so it stands in for 1/chance allocations like it
+    double weight = 1;
+    if (m_sampleInterval != 0) {
+        weight = 1 / -std::expm1(-static_cast<double>(size) / m_sampleInterval);
+    }
+
+    std::lock_guard lock(m_mutex);
+    auto it = m_samples.find(ptr);
+    if (it != m_samples.end()) {
+        // the pointer was reused without its free being seen, so the old
+        // sample isn't live anymore
+        auto& old = m_stats[it->second.owner];
+        old.liveBytes -= it->second.bytes;
+        old.liveAllocations -= it->second.count;
+        old.sampledAllocations -= 1;
+        it->second = Sample { owner, size * weight, weight };
+    }
+    else {
+        m_samples.emplace(ptr, Sample { owner, size * weight, weight });
+        this->bucketFor(ptr).fetch_add(1, std::memory_order_release);
+    }
+    auto& stats = m_stats[owner];
+    stats.liveBytes += size * weight;
+    stats.liveAllocations += weight;
+    stats.totalAllocations += weight;
+    stats.sampledAllocations += 1;
+}
+
+void AllocationTracker::freed(void const* ptr) {
+    // the allocation of ptr happens before its free, so if it was
+    // sampled its bucket can't read as empty here
+    if (!ptr || this->bucketFor(ptr).load(std::memory_order_acquire) == 0) {
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+    auto it = m_samples.find(ptr);
+    if (it == m_samples.end()) {
+        return;
+    }
+    auto& stats = m_stats[it->second.owner];
+    stats.liveBytes -= it->second.bytes;
+    stats.liveAllocations -= it->second.count;
+    stats.sampledAllocations -= 1;
+    m_samples.erase(it);
+    this->bucketFor(ptr).fetch_sub(1, std::memory_order_release);
+}
+
+AllocationTracker::Stats AllocationTracker::getStats(void const* owner) const {
+    std::lock_guard lock(m_mutex);
+    auto it = m_stats.find(owner);
+    return it != m_stats.end() ? it->second : Stats();
+}
+
+std::unordered_map<void const*, AllocationTracker::Stats> AllocationTracker::getAllStats() const {
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
+
+static std::atomic<AllocationTracker*> s_modTracker = nullptr;
+
+AllocationTracker* getModAllocationTracker() {
+    return s_modTracker.load(std::memory_order_acquire);
+}
+
+void enableModAllocationTracker(size_t sampleInterval) {
+    if (!s_modTracker) {
+        // lives for the rest of the session, since
+        // frees can come in at any point up to exit
+        s_modTracker = new AllocationTracker(sampleInterval);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * Keeps sampled counts of live allocations per owner. Owners are opaque
+ * pointers (mods, in practice) so this has no dependencies on the rest of
+ * the loader
+ */
+class AllocationTracker final {
+public:
+    struct Stats {
+        // estimates, extrapolated from the sampled allocations
+        double liveBytes = 0;
+        double liveAllocations = 0;
+        double totalAllocations = 0;
+        // how many allocations are actually being tracked right now
+        size_t sampledAllocations = 0;
+    };
+
+    /**
+     * @param sampleInterval Average number of allocated bytes between
+     * samples. 0 tracks every allocation
+     */
+    explicit AllocationTracker(size_t sampleInterval);
+    AllocationTracker(AllocationTracker const&) = delete;
+    AllocationTracker& operator=(AllocationTracker const&) = delete;
+
+    size_t getSampleInterval() const;
+
+    /**
+     * Record an allocation. Small allocations are only stored every so
+     * often, and weighted so the totals stay unbiased
+     */
+    void allocated(void const* owner, void const* ptr, size_t size);
+    /**
+     * Record a deallocation. Cheap for pointers that weren't sampled
+     */
+    void freed(void const* ptr);
+
+    Stats getStats(void const* owner) const;
+    std::unordered_map<void const*, Stats> getAllStats() const;
+
+private:
+    struct Sample {
+        void const* owner;
+        double bytes;
+        double count;
+    };
+
+    size_t m_sampleInterval;
+    // number of live samples whose pointer hashes to each bucket. checked
+    // without the lock, so freeing a pointer that can't have been sampled
+    // never takes it
+    std::array<std::atomic_uint32_t, 4096> m_sampledBuckets {};
+    mutable std::mutex m_mutex;
+    std::unordered_map<void const*, Sample> m_samples;
+    std::unordered_map<void const*, Stats> m_stats;
+
+    bool shouldSample(size_t size);
+    std::atomic_uint32_t& bucketFor(void const* ptr);
+};
+
+/**
+ * The tracker mod allocations are reported to, or nullptr when the
+ * "enable-memory-tracking" setting is off
+ */
+AllocationTracker* getModAllocationTracker();
+void enableModAllocationTracker(size_t sampleInterval);
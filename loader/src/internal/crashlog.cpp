@@ -1,20 +1,115 @@
 #include "crashlog.hpp"
 #include <fmt/core.h>
 #include "about.hpp"
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <ctime>
+#include <mutex>
+
+#ifdef GEODE_IS_WINDOWS
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
 
 using namespace geode::prelude;
 
-std::string crashlog::getDateString(bool filesafe) {
-    auto const now = std::time(nullptr);
-    auto const tm = *std::localtime(&now);
-    std::ostringstream oss;
-    if (filesafe) {
-        oss << std::put_time(&tm, "%F_%H-%M-%S");
-    }
-    else {
-        oss << std::put_time(&tm, "%FT%T%z"); // ISO 8601
+#ifdef GEODE_IS_WINDOWS
+using NativeString = std::wstring;
+using FileHandle = HANDLE;
+static FileHandle const INVALID_FILE = INVALID_HANDLE_VALUE;
+static wchar_t constexpr LOG_EXTENSION[] = L".log";
+#else
+using NativeString = std::string;
+using FileHandle = int;
+static FileHandle constexpr INVALID_FILE = -1;
+static char constexpr LOG_EXTENSION[] = ".log";
+#endif
+
+namespace {
+    // everything the crash handler needs that would otherwise
+    // require asking the loader or allocating
+    struct StateSnapshot {
+        std::string geodeInfo;
+        std::string mods;
+        std::vector<std::pair<Mod*, std::string>> faultyModMessages;
+        NativeString lastCrashedPath;
+        NativeString logPathPrefix;
+        // scratch space for building the log path, reserved up front
+        NativeString logPath;
+    };
+
+    // two slots so the crash handler can keep reading the current one
+    // while the other is being rebuilt
+    std::array<StateSnapshot, 2> s_snapshots;
+    std::atomic<StateSnapshot*> s_currentSnapshot = nullptr;
+    std::mutex s_snapshotMutex;
+}
+
+static NativeString toNativeString(ghc::filesystem::path const& path) {
+#ifdef GEODE_IS_WINDOWS
+    return path.wstring();
+#else
+    return path.string();
+#endif
+}
+
+static FileHandle openForAppend(NativeString const& path, bool truncate) {
+#ifdef GEODE_IS_WINDOWS
+    return CreateFileW(
+        path.c_str(), truncate ? GENERIC_WRITE : FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+        truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+#else
+    return open(path.c_str(), O_WRONLY | O_CREAT | (truncate ? O_TRUNC : O_APPEND), 0644);
+#endif
+}
+
+static void writeRaw(FileHandle file, std::string_view data) {
+    while (!data.empty()) {
+#ifdef GEODE_IS_WINDOWS
+        DWORD written = 0;
+        if (!WriteFile(file, data.data(), static_cast<DWORD>(data.size()), &written, nullptr)) {
+            return;
+        }
+#else
+        auto written = write(file, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+#endif
+        data.remove_prefix(static_cast<size_t>(written));
     }
-    return oss.str();
+}
+
+static void closeRaw(FileHandle file) {
+#ifdef GEODE_IS_WINDOWS
+    CloseHandle(file);
+#else
+    close(file);
+#endif
+}
+
+// formats the current date into the buffer without going through iostreams
+static std::string_view formatDate(char* buffer, size_t size, bool filesafe) {
+    auto const now = std::time(nullptr);
+    std::tm tm;
+#ifdef GEODE_IS_WINDOWS
+    localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
+    // ISO 8601 for the report itself
+    auto const len = std::strftime(buffer, size, filesafe ? "%F_%H-%M-%S" : "%FT%T%z", &tm);
+    return std::string_view(buffer, len);
+}
+
+std::string crashlog::getDateString(bool filesafe) {
+    std::array<char, 64> buffer;
+    return std::string(formatDate(buffer.data(), buffer.size(), filesafe));
 }
 
 void crashlog::printGeodeInfo(std::stringstream& stream) {
@@ -22,7 +117,7 @@ void crashlog::printGeodeInfo(std::stringstream& stream) {
            << "Loader Commit: " << LOADER_COMMIT_HASH << "\n"
            << "Bindings Commit: " << BINDINGS_COMMIT_HASH << "\n"
            << "Installed mods: " << Loader::get()->getAllMods().size() << "\n"
-           << "Problems: " << Loader::get()->getProblems().size() << "\n";
+           << "Problems: " << Loader::get()->getProblemCount() << "\n";
 }
 
 void crashlog::printMods(std::stringstream& stream) {
@@ -39,53 +134,112 @@ void crashlog::printMods(std::stringstream& stream) {
     }
 }
 
-std::string crashlog::writeCrashlog(geode::Mod* faultyMod, std::string const& info, std::string const& stacktrace, std::string const& registers) {
-    // make sure crashlog directory exists
-    (void)utils::file::createDirectoryAll(crashlog::getCrashLogDirectory());
+static std::string formatFaultyModMessage(Mod* mod) {
+    return fmt::format(
+        "It appears that the crash occurred while executing code from "
+        "the \"{}\" mod. Please submit this crash report to its developer ({}) for assistance.\n",
+        mod->getID(), mod->getDeveloper()
+    );
+}
 
-    // add a file to let Geode know on next launch that it crashed previously
-    // this could also be done by saving a loader setting or smth but eh.
-    (void)utils::file::writeBinary(crashlog::getCrashLogDirectory() / "last-crashed", {});
-    
-    std::stringstream file;
+void crashlog::updateStateSnapshot() {
+    std::lock_guard lock(s_snapshotMutex);
 
-    file << getDateString(false) << "\n"
-         << std::showbase << "Whoopsies! An unhandled exception has occured.\n";
+    auto* snapshot = &s_snapshots[0];
+    if (s_currentSnapshot.load() == snapshot) {
+        snapshot = &s_snapshots[1];
+    }
 
-    if (faultyMod) {
-        file << "It appears that the crash occurred while executing code from "
-             << "the \"" << faultyMod->getID() << "\" mod. "
-             << "Please submit this crash report to its developer (" << faultyMod->getDeveloper()
-             << ") for assistance.\n";
+    std::stringstream info;
+    printGeodeInfo(info);
+    snapshot->geodeInfo = info.str();
+
+    std::stringstream mods;
+    printMods(mods);
+    snapshot->mods = mods.str();
+
+    snapshot->faultyModMessages.clear();
+    for (auto mod : Loader::get()->getAllMods()) {
+        snapshot->faultyModMessages.emplace_back(mod, formatFaultyModMessage(mod));
+    }
+
+    auto const dir = crashlog::getCrashLogDirectory();
+    (void)utils::file::createDirectoryAll(dir);
+    snapshot->lastCrashedPath = toNativeString(dir / "last-crashed");
+    snapshot->logPathPrefix = toNativeString(dir / "");
+    // room for the date and extension
+    snapshot->logPath.reserve(snapshot->logPathPrefix.size() + 64);
+
+#ifndef GEODE_IS_WINDOWS
+    // make localtime_r not have to load the timezone while crashing
+    tzset();
+#endif
+
+    s_currentSnapshot = snapshot;
+}
+
+std::string crashlog::writeCrashlog(geode::Mod* faultyMod, std::string const& info, std::string const& stacktrace, std::string const& registers) {
+    auto* snapshot = s_currentSnapshot.load();
+    if (!snapshot) {
+        // crashed before the loader was set up, there's no better time than now
+        crashlog::updateStateSnapshot();
+        snapshot = s_currentSnapshot.load();
     }
 
-    // geode info
-    file << "\n== Geode Information ==\n";
-    printGeodeInfo(file);
+    std::string_view faultyModMessage;
+    // only used if the mod isn't in the snapshot
+    std::string faultyModMessageStorage;
+    if (faultyMod) {
+        for (auto const& [mod, message] : snapshot->faultyModMessages) {
+            if (mod == faultyMod) {
+                faultyModMessage = message;
+                break;
+            }
+        }
+        if (faultyModMessage.empty()) {
+            faultyModMessageStorage = formatFaultyModMessage(faultyMod);
+            faultyModMessage = faultyModMessageStorage;
+        }
+    }
 
-    // exception info
-    file << "\n== Exception Information ==\n";
-    file << info;
+    std::array<char, 64> dateBuffer;
+    auto const date = formatDate(dateBuffer.data(), dateBuffer.size(), false);
 
-    // stack trace
-    file << "\n== Stack Trace ==\n";
-    file << stacktrace;
+    std::array<std::string_view, 14> const sections = {
+        date, "\n",
+        "Whoopsies! An unhandled exception has occured.\n",
+        faultyModMessage,
+        "\n== Geode Information ==\n", snapshot->geodeInfo,
+        "\n== Exception Information ==\n", info,
+        "\n== Stack Trace ==\n", stacktrace,
+        "\n== Register States ==\n", registers,
+        "\n== Installed Mods ==\n", snapshot->mods,
+    };
 
-    // registers
-    file << "\n== Register States ==\n";
-    file << registers;
+    // let Geode know on next launch that it crashed previously
+    auto marker = openForAppend(snapshot->lastCrashedPath, true);
+    if (marker != INVALID_FILE) {
+        closeRaw(marker);
+    }
 
-    // mods
-    file << "\n== Installed Mods ==\n";
-    printMods(file);
+    std::array<char, 64> fileDateBuffer;
+    auto const fileDate = formatDate(fileDateBuffer.data(), fileDateBuffer.size(), true);
+    snapshot->logPath.assign(snapshot->logPathPrefix);
+    snapshot->logPath.append(fileDate.begin(), fileDate.end());
+    snapshot->logPath.append(LOG_EXTENSION);
 
-    // save actual file
-    std::ofstream actualFile;
-    actualFile.open(
-        crashlog::getCrashLogDirectory() / (getDateString(true) + ".log"), std::ios::app
-    );
-    actualFile << file.rdbuf() << std::flush;
-    actualFile.close();
+    auto file = openForAppend(snapshot->logPath, false);
+    if (file != INVALID_FILE) {
+        for (auto section : sections) {
+            writeRaw(file, section);
+        }
+        closeRaw(file);
+    }
 
-    return file.str();
+    // the report is on disk, now it's fine to allocate for the caller
+    std::string text;
+    for (auto section : sections) {
+        text += section;
+    }
+    return text;
 }
@@ -31,8 +31,21 @@ namespace crashlog {
      */
     ghc::filesystem::path GEODE_DLL getCrashLogDirectory();
 
+    /**
+     * Write a crash report to the crashlog directory. The Geode info and mod
+     * list come from the snapshot made by updateStateSnapshot, and the file
+     * is written with raw system calls, so this doesn't have to touch the
+     * loader or the heap before the report is on disk
+     * @returns The full text of the report
+     */
     std::string GEODE_DLL writeCrashlog(geode::Mod* faultyMod, std::string const& info, std::string const& stacktrace, std::string const& registers);
 
+    /**
+     * Re-render the loader state shown in crash reports. Should be called
+     * whenever the mod list or the state of a mod changes
+     */
+    void updateStateSnapshot();
+
     std::string getDateString(bool filesafe);
 
     void printGeodeInfo(std::stringstream& stream);
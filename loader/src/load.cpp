@@ -1,3 +1,4 @@
+#include <loader/HookImpl.hpp>
 #include <loader/LoaderImpl.hpp>
 #include <loader/console.hpp>
 #include <loader/IPC.hpp>
@@ -11,7 +12,9 @@
 #include <Geode/loader/ModJsonTest.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <loader/LogImpl.hpp>
+#include <AllocationTracker.hpp>
 
+#include <algorithm>
 #include <array>
 
 using namespace geode::prelude;
@@ -59,6 +62,46 @@ $execute {
 
         return res;
     });
+
+    ipc::listen("hook-profile", [](ipc::IPCEvent* event) -> matjson::Value {
+        if (!hook::isProfilingEnabled()) {
+            return matjson::Value();
+        }
+
+        // mods sorted by how much time their own hooks take up
+        std::vector<matjson::Value> res;
+        for (auto& mod : Loader::get()->getAllMods()) {
+            auto runtime = mod->getRuntimeInfo()["runtime"];
+            auto json = matjson::Object();
+            json["id"] = mod->getID();
+            json["profile"] = runtime["profile"];
+            json["hooks"] = runtime["hooks"];
+            res.push_back(json);
+        }
+        std::sort(res.begin(), res.end(), [](auto& a, auto& b) {
+            return a["profile"]["exclusive-ms"].as_double() > b["profile"]["exclusive-ms"].as_double();
+        });
+        return res;
+    });
+
+    ipc::listen("memory-usage", [](ipc::IPCEvent* event) -> matjson::Value {
+        if (!getModAllocationTracker()) {
+            return matjson::Value();
+        }
+
+        // mods sorted by how much memory they're estimated to hold on to
+        std::vector<matjson::Value> res;
+        for (auto& mod : Loader::get()->getAllMods()) {
+            auto json = matjson::Object();
+            json["id"] = mod->getID();
+            json["memory"] = mod->getRuntimeInfo()["runtime"]["memory"];
+            res.push_back(json);
+        }
+        std::sort(res.begin(), res.end(), [](auto& a, auto& b) {
+            return a["memory"]["live-bytes"].as_double() > b["memory"]["live-bytes"].as_double();
+        });
+        return res;
+    });
 }
 
 void tryLogForwardCompat() {
@@ -130,6 +173,20 @@ int geodeEntry(void* platformData) {
 
     tryShowForwardCompat();
 
+    // only hooks created after this point are instrumented,
+    // which is every mod's but not the loader's own
+    if (Mod::get()->getSettingValue<bool>("enable-hook-profiling")) {
+        log::info("Hook profiling enabled");
+        hook::setProfilingEnabled(true);
+    }
+
+    if (Mod::get()->getSettingValue<bool>("enable-memory-tracking")) {
+        log::info("Memory tracking enabled");
+        // field allocations are small, so this
+        // samples roughly one in every few hundred
+        enableModAllocationTracker(16 * 1024);
+    }
+
     // open console
     if (LoaderImpl::get()->isForwardCompatMode() ||
         Mod::get()->getSettingValue<bool>("show-platform-console")) {
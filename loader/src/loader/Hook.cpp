@@ -1,8 +1,42 @@
 #include <Geode/loader/Hook.hpp>
 #include "HookImpl.hpp"
 
+#include <mutex>
+#include <unordered_map>
+
 using namespace geode::prelude;
 
+static std::atomic_bool s_profilingEnabled = false;
+static std::mutex s_profilesMutex;
+static std::unordered_map<void*, hook::HookProfile*> s_profiles;
+static thread_local hook::ProfileScope* s_currentScope = nullptr;
+
+void geode::hook::setProfilingEnabled(bool enabled) {
+    s_profilingEnabled = enabled;
+}
+
+bool geode::hook::isProfilingEnabled() {
+    return s_profilingEnabled.load(std::memory_order_relaxed);
+}
+
+void geode::hook::registerProfile(void* detour, HookProfile* profile) {
+    std::lock_guard lock(s_profilesMutex);
+    s_profiles[detour] = profile;
+}
+
+hook::HookProfile* geode::hook::getProfile(void* detour) {
+    if (!isProfilingEnabled()) {
+        return nullptr;
+    }
+    std::lock_guard lock(s_profilesMutex);
+    auto it = s_profiles.find(detour);
+    return it != s_profiles.end() ? it->second : nullptr;
+}
+
+hook::ProfileScope* geode::hook::exchangeProfileScope(ProfileScope* scope) {
+    return std::exchange(s_currentScope, scope);
+}
+
 Hook::Hook(std::shared_ptr<Impl>&& impl) : m_impl(std::move(impl)) { m_impl->m_self = this; }
 Hook::~Hook() = default;
 
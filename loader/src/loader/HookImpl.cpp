@@ -103,6 +103,13 @@ matjson::Value Hook::Impl::getRuntimeInfo() const {
     json["detour"] = std::to_string(reinterpret_cast<uintptr_t>(m_detour));
     json["name"] = m_displayName;
     json["enabled"] = m_enabled;
+    if (auto profile = hook::getProfile(m_detour)) {
+        auto stats = matjson::Object();
+        stats["calls"] = static_cast<double>(profile->calls.load(std::memory_order_relaxed));
+        stats["inclusive-ms"] = profile->inclusiveNanoseconds.load(std::memory_order_relaxed) / 1e6;
+        stats["exclusive-ms"] = profile->exclusiveNanoseconds.load(std::memory_order_relaxed) / 1e6;
+        json["profile"] = stats;
+    }
     return json;
 }
 
@@ -11,6 +11,13 @@
 
 using namespace geode::prelude;
 
+namespace geode::hook {
+    /**
+     * Turn instrumentation on for hooks created from now on
+     */
+    void setProfilingEnabled(bool enabled);
+}
+
 class Hook::Impl final : ModPatch {
 public:
     Impl(
@@ -5,8 +5,10 @@
 #include <Geode/utils/web.hpp>
 #include <Geode/utils/string.hpp>
 #include <Geode/utils/map.hpp>
+#include <Geode/utils/thread.hpp>
 #include <hash/hash.hpp>
 #include <Geode/utils/JsonValidation.hpp>
+#include "IndexDelta.hpp"
 
 #include <thread>
 
@@ -15,6 +17,7 @@
 #endif
 
 using namespace geode::prelude;
+using namespace geode::index_delta;
 
 // ModInstallEvent
 
@@ -45,6 +48,20 @@ ListenerResult IndexUpdateFilter::handle(
 
 IndexUpdateFilter::IndexUpdateFilter() {}
 
+// IndexUpdateStatusEvent
+
+IndexUpdateStatusEvent::IndexUpdateStatusEvent() {}
+
+ListenerResult IndexUpdateStatusFilter::handle(
+    utils::MiniFunction<Callback> fn,
+    IndexUpdateStatusEvent* event
+) {
+    fn(event);
+    return ListenerResult::Propagate;
+}
+
+IndexUpdateStatusFilter::IndexUpdateStatusFilter() {}
+
 // IndexItem
 
 class IndexItem::Impl final {
@@ -236,6 +253,65 @@ static Result<> flattenGithubRepo(ghc::filesystem::path const& dir) {
     return Ok();
 }
 
+// github's compare API lists at most 300 files, and past a point a single 
+// zipball download is cheaper than fetching every changed file anyway
+static constexpr size_t MAX_INDEX_DELTA_FILES = 64;
+
+static Result<std::vector<IndexChange>> parseIndexChanges(matjson::Value const& json) {
+    if (!json.is_object() || !json.contains("status") || !json.contains("files")) {
+        return Err("Invalid compare response");
+    }
+    auto status = json["status"];
+    if (!status.is_string() || (status.as_string() != "ahead" && status.as_string() != "identical")) {
+        return Err("Local index is not an ancestor of the latest commit");
+    }
+    auto files = json["files"];
+    if (!files.is_array()) {
+        return Err("Invalid compare response");
+    }
+    if (files.as_array().size() > MAX_INDEX_DELTA_FILES) {
+        return Err(fmt::format("Too many changed files ({})", files.as_array().size()));
+    }
+    std::vector<IndexChange> changes;
+    for (auto& file : files.as_array()) {
+        if (
+            !file.is_object() ||
+            !file.contains("filename") || !file["filename"].is_string() ||
+            !file.contains("status") || !file["status"].is_string()
+        ) {
+            return Err("Invalid file in compare response");
+        }
+        IndexChange change;
+        change.path = file["filename"].as_string();
+        // don't let the response write outside of the index
+        for (auto& part : ghc::filesystem::path(change.path)) {
+            if (part == "..") {
+                return Err(fmt::format("Invalid file path '{}'", change.path));
+            }
+        }
+        auto fileStatus = file["status"].as_string();
+        if (fileStatus == "removed") {
+            change.removed = true;
+        }
+        else {
+            if (!file.contains("raw_url") || !file["raw_url"].is_string()) {
+                return Err(fmt::format("No download for changed file '{}'", change.path));
+            }
+            change.url = file["raw_url"].as_string();
+            if (fileStatus == "renamed" && file.contains("previous_filename")) {
+                change.previousPath = file["previous_filename"].as_string();
+                for (auto& part : ghc::filesystem::path(change.previousPath)) {
+                    if (part == "..") {
+                        return Err(fmt::format("Invalid file path '{}'", change.previousPath));
+                    }
+                }
+            }
+        }
+        changes.push_back(change);
+    }
+    return Ok(changes);
+}
+
 // Index impl
 
 class Index::Impl final {
@@ -254,14 +330,27 @@ private:
     std::atomic<bool> m_triedToUpdate = false;
     std::mutex m_itemsMutex;
     std::unordered_map<std::string, ItemVersions> m_items;
+    std::mutex m_updateStatusesMutex;
+    std::unordered_map<std::string, ModUpdateStatus> m_updateStatuses;
 
     friend class Index;
 
     void cleanupItems();
     void downloadIndex(std::string commitHash = "");
+    void downloadIndexDelta(std::string const& oldSHA, std::string const& newSHA);
+    Result<std::vector<ByteVector>> fetchIndexChanges(
+        std::vector<IndexChange> const& changes
+    );
+    Result<> applyIndexChanges(
+        std::vector<IndexChange> const& changes,
+        std::vector<ByteVector> const& contents
+    );
     void checkForUpdates();
-    void updateFromLocalTree();
+    void updateFromLocalTree(
+        TouchedEntries const& touched = std::nullopt
+    );
     void installNext(size_t index, IndexInstallList const& list);
+    void rebuildUpdateStatuses();
 
 public:
     Impl() {
@@ -319,6 +408,8 @@ void Index::Impl::downloadIndex(std::string commitHash) {
         .fetch("https://github.com/geode-sdk/mods/zipball/main")
         .into(targetFile)
         .then([this, targetFile, commitHash](auto) {
+            // unzipping and parsing the whole index takes a while, so it
+            // gets its own thread instead of a pool worker
             std::thread([=, this]() {
                 auto targetDir = dirs::getIndexDir() / "v0";
                 // delete old unzipped index
@@ -369,6 +460,115 @@ void Index::Impl::downloadIndex(std::string commitHash) {
         });
 }
 
+void Index::Impl::downloadIndexDelta(std::string const& oldSHA, std::string const& newSHA) {
+    log::debug("Fetching index changes since {}", oldSHA);
+
+    IndexUpdateEvent(UpdateProgress(0, "Fetching changes")).post();
+
+    web::AsyncWebRequest()
+        .join("index-delta")
+        .userAgent("github_api/1.0")
+        .header("Accept: application/vnd.github+json")
+        .fetch(fmt::format(
+            "https://api.github.com/repos/geode-sdk/mods/compare/{}...{}", oldSHA, newSHA
+        ))
+        .json()
+        .then([this, newSHA](matjson::Value const& json) {
+            auto changes = parseIndexChanges(json);
+            if (!changes) {
+                log::info("Downloading full index: {}", changes.unwrapErr());
+                this->downloadIndex(newSHA);
+                return;
+            }
+            auto fail = [this, newSHA](std::string const& error) {
+                log::warn("Unable to apply index changes: {}", error);
+                Loader::get()->queueInMainThread([this, newSHA] {
+                    this->downloadIndex(newSHA);
+                });
+            };
+            // the files are fetched one by one with blocking requests, and
+            // the index is re-parsed afterwards, which would tie up a pool
+            // worker for a long time
+            std::thread([=, this]() {
+                auto contents = this->fetchIndexChanges(changes.unwrap());
+                if (!contents) {
+                    return fail(contents.unwrapErr());
+                }
+                auto res = this->applyIndexChanges(changes.unwrap(), contents.unwrap());
+                if (!res) {
+                    return fail(res.unwrapErr());
+                }
+                auto const checksumPath = dirs::getIndexDir() / ".checksum";
+                (void)file::writeString(checksumPath, newSHA);
+
+                // changes outside of mods-v2 (like config.json) may affect 
+                // every entry, in which case everything gets re-parsed
+                this->updateFromLocalTree(touchedIndexEntries(changes.unwrap()));
+            }).detach();
+        })
+        .expect([this, newSHA](std::string const& err) {
+            log::info("Unable to fetch index changes, downloading full index: {}", err);
+            this->downloadIndex(newSHA);
+        });
+}
+
+Result<std::vector<ByteVector>> Index::Impl::fetchIndexChanges(
+    std::vector<IndexChange> const& changes
+) {
+    std::vector<ByteVector> contents;
+    contents.reserve(changes.size());
+    size_t done = 0;
+    for (auto& change : changes) {
+        Loader::get()->queueInMainThread([done, total = changes.size()] {
+            IndexUpdateEvent(UpdateProgress(
+                static_cast<uint8_t>(done * 100 / total), "Downloading changes"
+            )).post();
+        });
+        done += 1;
+
+        if (change.removed) {
+            contents.emplace_back();
+            continue;
+        }
+        GEODE_UNWRAP_INTO(
+            auto data, web::fetchBytes(change.url)
+                .expect("Unable to download {}: {error}", change.path)
+        );
+        contents.push_back(std::move(data));
+    }
+    return Ok(std::move(contents));
+}
+
+Result<> Index::Impl::applyIndexChanges(
+    std::vector<IndexChange> const& changes,
+    std::vector<ByteVector> const& contents
+) {
+    auto indexRoot = dirs::getIndexDir() / "v0";
+    for (size_t i = 0; i < changes.size(); i++) {
+        auto& change = changes[i];
+
+        std::error_code ec;
+        if (!change.previousPath.empty()) {
+            ghc::filesystem::remove(indexRoot / change.previousPath, ec);
+        }
+
+        auto target = indexRoot / change.path;
+        if (change.removed) {
+            ghc::filesystem::remove(target, ec);
+            if (ec) {
+                return Err("Unable to remove {}: {}", change.path, ec.message());
+            }
+            continue;
+        }
+        GEODE_UNWRAP(file::createDirectoryAll(target.parent_path()));
+        GEODE_UNWRAP(
+            file::writeBinary(target, contents.at(i))
+                .expect("Unable to write {}: {error}", change.path)
+        );
+    }
+    return Ok();
+}
+
 void Index::Impl::checkForUpdates() {
     if (m_isUpToDate) {
         std::thread([this](){
@@ -404,6 +604,13 @@ void Index::Impl::checkForUpdates() {
             ) {
                 this->updateFromLocalTree();
             }
+            // if there is a local copy to patch, only fetch what changed
+            else if (
+                !oldSHA.empty() && !newSHA.empty() &&
+                ghc::filesystem::exists(dirs::getIndexDir() / "v0" / "config.json")
+            ) {
+                this->downloadIndexDelta(oldSHA, newSHA);
+            }
             // otherwise save hash and download source
             else {
                 this->downloadIndex(newSHA);
@@ -416,7 +623,7 @@ void Index::Impl::checkForUpdates() {
         });
 }
 
-void Index::Impl::updateFromLocalTree() {
+void Index::Impl::updateFromLocalTree(TouchedEntries const& touched) {
     log::debug("Updating local index cache");
     log::pushNest();
     std::unique_lock<std::mutex> lock(m_itemsMutex);
@@ -424,10 +631,31 @@ void Index::Impl::updateFromLocalTree() {
     Loader::get()->queueInMainThread([](){
         IndexUpdateEvent(UpdateProgress(100, "Updating local cache")).post();
     });
-    // delete old items
+    // delete old items, keeping them around for reuse if only part of the 
+    // tree changed
+    std::unordered_map<std::string, ItemVersions> previous;
+    if (touched) {
+        previous = std::move(m_items);
+    }
     m_items.clear();
     lock.unlock();
 
+    auto reusable = [&](std::string const& modID, std::string const& version, 
+        ghc::filesystem::path const& dir) -> IndexItemHandle {
+        if (!isEntryReusable(touched, modID, version)) {
+            return nullptr;
+        }
+        if (!previous.count(modID)) {
+            return nullptr;
+        }
+        for (auto& [_, item] : previous.at(modID)) {
+            if (item->getPath() == dir) {
+                return item;
+            }
+        }
+        return nullptr;
+    };
+
     auto indexRoot = dirs::getIndexDir() / "v0";
     auto entriesRoot = indexRoot / "mods-v2";
 
@@ -446,6 +674,13 @@ void Index::Impl::updateFromLocalTree() {
             auto rootDir = entriesRoot / modID;
             auto dir = rootDir / version.get<std::string>();
 
+            if (auto item = reusable(modID, version.get<std::string>(), dir)) {
+                lock.lock();
+                m_items[modID].insert({item->getMetadata().getVersion(), item});
+                lock.unlock();
+                continue;
+            }
+
             auto addRes = IndexItem::Impl::create(rootDir, dir);
             if (!addRes) {
                 // log::warn("Unable to add index item from {}: {}", dir, addRes.unwrapErr());
@@ -465,7 +700,8 @@ void Index::Impl::updateFromLocalTree() {
     // mark source as finished
     m_isUpToDate = true;
     
-    Loader::get()->queueInMainThread([](){
+    Loader::get()->queueInMainThread([this](){
+        this->rebuildUpdateStatuses();
         IndexUpdateEvent(UpdateFinished()).post();
     });
 
@@ -627,15 +863,61 @@ bool Index::isUpdateAvailable(IndexItemHandle item) const {
 }
 
 bool Index::areUpdatesAvailable() const {
-    for (auto& mod : Loader::get()->getAllMods()) {
-        auto item = this->getMajorItem(mod->getID());
-        if (item && item->getMetadata().getVersion() > mod->getVersion() && mod->isEnabled()) {
+    std::scoped_lock lock(m_impl->m_updateStatusesMutex);
+    for (auto& [id, status] : m_impl->m_updateStatuses) {
+        if (!status.updateAvailable) continue;
+        auto mod = Loader::get()->getInstalledMod(id);
+        if (mod && mod->isEnabled()) {
             return true;
         }
     }
     return false;
 }
 
+std::optional<ModUpdateStatus> Index::getUpdateStatus(std::string const& id) const {
+    // mods can be uninstalled after the statuses were calculated
+    if (!Loader::get()->getInstalledMod(id)) {
+        return std::nullopt;
+    }
+    std::scoped_lock lock(m_impl->m_updateStatusesMutex);
+    if (m_impl->m_updateStatuses.count(id)) {
+        return m_impl->m_updateStatuses.at(id);
+    }
+    return std::nullopt;
+}
+
+void Index::Impl::rebuildUpdateStatuses() {
+    std::unordered_map<std::string, ModUpdateStatus> statuses;
+    {
+        std::scoped_lock lock(m_itemsMutex);
+        for (auto& mod : Loader::get()->getAllMods()) {
+            if (mod->isUninstalled()) continue;
+            auto it = m_items.find(mod->getID());
+            if (it == m_items.end() || it->second.empty()) continue;
+
+            auto installed = mod->getVersion();
+            auto compatible = ComparableVersionInfo(installed, VersionCompare::MoreEq);
+
+            ModUpdateStatus status;
+            status.latestMajor = it->second.rbegin()->second;
+            for (auto& [version, item] : ranges::reverse(it->second)) {
+                if (compatible.compare(version)) {
+                    status.latestCompatible = item;
+                    break;
+                }
+            }
+            status.updateAvailable = 
+                status.latestMajor->getMetadata().getVersion() > installed;
+            statuses.insert({ mod->getID(), std::move(status) });
+        }
+    }
+    {
+        std::scoped_lock lock(m_updateStatusesMutex);
+        m_updateStatuses = std::move(statuses);
+    }
+    IndexUpdateStatusEvent().post();
+}
+
 // Item installation
 
 Result<> Index::canInstall(IndexItemHandle item) const {
@@ -766,7 +1048,8 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
         }
 
         auto const& eventModID = list.target->getMetadata().getID();
-        Loader::get()->queueInMainThread([eventModID]() {
+        Loader::get()->queueInMainThread([this, eventModID]() {
+            this->rebuildUpdateStatuses();
             ModInstallEvent(eventModID, UpdateFinished()).post();
         });
 
@@ -806,21 +1089,26 @@ void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
                 )
             ).post();
 
-            if (::calculateHash(tempFile) != item->getPackageHash()) {
-                return postError(fmt::format(
-                    "Checksum mismatch with {}! (Downloaded file did not match what "
-                    "was expected. Try again, and if the download fails another time, "
-                    "report this to the Geode development team.)",
-                    item->getMetadata().getID()
-                ));
-            }
+            // hash on another thread as mods can be several megabytes
+            utils::thread::async([=]() {
+                return ::calculateHash(tempFile) == item->getPackageHash();
+            }).then([=, this](bool const& matches) {
+                if (!matches) {
+                    return postError(fmt::format(
+                        "Checksum mismatch with {}! (Downloaded file did not match what "
+                        "was expected. Try again, and if the download fails another time, "
+                        "report this to the Geode development team.)",
+                        item->getMetadata().getID()
+                    ));
+                }
 
-            item->setIsInstalled(true);
+                item->setIsInstalled(true);
 
-            log::debug("Installed {}", item->getMetadata().getID());
+                log::debug("Installed {}", item->getMetadata().getID());
 
-            // Install next item in queue
-            this->installNext(index + 1, list);
+                // Install next item in queue
+                this->installNext(index + 1, list);
+            }, utils::thread::RunOn::MainThread);
         })
         .expect([postError, list, item](std::string const& err) {
             postError(fmt::format(
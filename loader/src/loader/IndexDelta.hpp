@@ -0,0 +1,71 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Bookkeeping for patching the local index tree in place. This only depends
+// on the standard library so it can be unit tested on its own (see
+// loader/test/unit)
+namespace geode::index_delta {
+    // Index changes between two commits of the index repo, as reported by
+    // github's compare API
+    struct IndexChange {
+        std::string path;
+        std::string previousPath;
+        std::string url;
+        bool removed = false;
+    };
+
+    // The entries of the index that need to be re-parsed after applying a set
+    // of changes, either whole mods (`id`) or single versions (`id/version`).
+    // No value means that the whole index has to be rebuilt
+    using TouchedEntries = std::optional<std::unordered_set<std::string>>;
+
+    // Returns the part of the index a changed file belongs to, either a whole
+    // mod (`id`) or a single version of it (`id/version`). Files outside of
+    // `mods-v2/<id>/` (like config.json) don't belong to any single entry
+    inline std::optional<std::string> touchedIndexEntry(std::string const& path) {
+        std::vector<std::string> parts;
+        size_t start = 0;
+        while (true) {
+            auto end = path.find('/', start);
+            parts.push_back(path.substr(start, end - start));
+            if (end == std::string::npos) break;
+            start = end + 1;
+        }
+        if (parts.size() < 3 || parts[0] != "mods-v2") {
+            return std::nullopt;
+        }
+        if (parts.size() >= 4) {
+            return parts[1] + "/" + parts[2];
+        }
+        return parts[1];
+    }
+
+    inline TouchedEntries touchedIndexEntries(std::vector<IndexChange> const& changes) {
+        std::unordered_set<std::string> touched;
+        for (auto& change : changes) {
+            for (auto path : { &change.previousPath, &change.path }) {
+                if (path->empty()) {
+                    continue;
+                }
+                auto entry = touchedIndexEntry(*path);
+                // a file outside of any single entry may affect all of them
+                if (!entry) {
+                    return std::nullopt;
+                }
+                touched.insert(*entry);
+            }
+        }
+        return touched;
+    }
+
+    // Whether the previously parsed item for this version can be kept as is
+    inline bool isEntryReusable(
+        TouchedEntries const& touched, std::string const& modID, std::string const& version
+    ) {
+        return touched && !touched->count(modID) && !touched->count(modID + "/" + version);
+    }
+}
@@ -69,6 +69,18 @@ std::vector<LoadProblem> Loader::getProblems() const {
     return m_impl->getProblems();
 }
 
+std::vector<LoadProblem> Loader::getProblems(Mod* mod) const {
+    return m_impl->getProblems(mod);
+}
+
+size_t Loader::getProblemCount() const {
+    return m_impl->getProblemCount();
+}
+
+size_t Loader::getProblemCount(LoadProblem::Type type) const {
+    return m_impl->getProblemCount(type);
+}
+
 void Loader::queueInMainThread(ScheduledFunction func) {
     return m_impl->queueInMainThread(std::move(func));
 }
@@ -12,18 +12,25 @@
 #include <Geode/loader/Log.hpp>
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/JsonValidation.hpp>
+#include <Geode/utils/cocos.hpp>
 #include <Geode/utils/file.hpp>
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <Geode/utils/string.hpp>
+#include <Geode/utils/thread.hpp>
 #include <Geode/utils/web.hpp>
 #include <about.hpp>
 #include <crashlog.hpp>
 #include <fmt/format.h>
 #include <hash.hpp>
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <iostream>
+#include <map>
 #include <resources.hpp>
 #include <string>
+#include <tuple>
 #include <vector>
 
 using namespace geode::prelude;
@@ -73,6 +80,7 @@ Result<> Loader::Impl::setup() {
     if (!crashlog::setupPlatformHandler()) {
         log::debug("Failed to set up crash handler");
     }
+    crashlog::updateStateSnapshot();
     log::popNest();
 
     log::debug("Loading hooks");
@@ -101,15 +109,37 @@ void Loader::Impl::addSearchPaths() {
 }
 
 void Loader::Impl::updateResources(bool forceReload) {
-    log::debug("Adding resources");
-    log::pushNest();
-    for (auto const& [_, mod] : m_mods) {
-        if (!forceReload && ModImpl::getImpl(mod)->m_resourcesLoaded)
-            continue;
-        this->updateModResources(mod);
-        ModImpl::getImpl(mod)->m_resourcesLoaded = true;
+    auto batch = this->collectResources(forceReload);
+    batch->decodeAll();
+    batch->uploadReady();
+}
+
+void Loader::Impl::updateResourcesAsync(
+    bool forceReload,
+    utils::MiniFunction<void(size_t, size_t)> onProgress,
+    utils::MiniFunction<void()> onFinished
+) {
+    auto batch = this->collectResources(forceReload);
+    if (batch->sheets.empty()) {
+        if (onFinished) onFinished();
+        return;
+    }
+    for (size_t i = 0; i < batch->workerCount(); i++) {
+        utils::thread::async([=, this]() {
+            batch->decode([&]() {
+                // every decoded sheet schedules one upload pass, so the
+                // pass after the last decode is guaranteed to finish up
+                queueInMainThread([=]() {
+                    if (batch->nextToUpload >= batch->sheets.size()) {
+                        return;
+                    }
+                    auto finished = batch->uploadReady();
+                    if (onProgress) onProgress(batch->decodedCount, batch->sheets.size());
+                    if (finished && onFinished) onFinished();
+                });
+            });
+        });
     }
-    log::popNest();
 }
 
 std::vector<Mod*> Loader::Impl::getAllMods() {
@@ -197,7 +227,222 @@ Mod* Loader::Impl::getLoadedMod(std::string const& id) const {
     return nullptr;
 }
 
-void Loader::Impl::updateModResources(Mod* mod) {
+struct geode::SpritesheetBatch {
+    struct Sheet {
+        // names as the mod lists them, used if decoding fails
+        std::string png;
+        std::string plist;
+        // resolved on the main thread, so texture pack overrides apply
+        std::string pngPath;
+        std::string plistPath;
+        CCImage* image = nullptr;
+        CCDictionary* frames = nullptr;
+        std::atomic_bool decoded = false;
+    };
+
+    // deque so sheets don't need to be movable
+    std::deque<Sheet> sheets;
+    std::atomic_size_t nextToDecode = 0;
+    std::atomic_size_t decodedCount = 0;
+    // only touched on the main thread
+    size_t nextToUpload = 0;
+
+    size_t workerCount() const {
+        return std::min(utils::thread::getWorkerCount(), sheets.size());
+    }
+
+    // safe to call from any number of threads at once
+    void decode(utils::MiniFunction<void()> const& onDecoded = nullptr) {
+        while (true) {
+            auto index = nextToDecode++;
+            if (index >= sheets.size()) {
+                return;
+            }
+            auto& sheet = sheets[index];
+
+            auto image = new CCImage();
+            if (image->initWithImageFileThreadSafe(sheet.pngPath.c_str(), CCImage::kFmtPng)) {
+                sheet.image = image;
+            }
+            else {
+                image->release();
+            }
+            sheet.frames = CCDictionary::createWithContentsOfFileThreadSafe(sheet.plistPath.c_str());
+
+            sheet.decoded.store(true, std::memory_order_release);
+            ++decodedCount;
+            if (onDecoded) onDecoded();
+        }
+    }
+
+    void decodeAll() {
+        std::vector<utils::thread::Task<void>> helpers;
+        for (size_t i = 1; i < this->workerCount(); i++) {
+            helpers.push_back(utils::thread::async([this]() { this->decode(); }));
+        }
+        this->decode();
+        for (auto& helper : helpers) {
+            helper.wait();
+        }
+    }
+
+    // uploads every decoded sheet that's next in line, returns true
+    // once everything has been uploaded
+    bool uploadReady() {
+        while (nextToUpload < sheets.size()) {
+            auto& sheet = sheets[nextToUpload];
+            if (!sheet.decoded.load(std::memory_order_acquire)) {
+                return false;
+            }
+            upload(sheet);
+            nextToUpload += 1;
+        }
+        return true;
+    }
+
+    static CCTexture2D* addTexture(CCImage* image, std::string const& path) {
+        auto cache = CCTextureCache::get();
+        if (auto existing = static_cast<CCTexture2D*>(cache->m_pTextures->objectForKey(path))) {
+            return existing;
+        }
+        auto texture = new CCTexture2D();
+        if (!texture->initWithImage(image)) {
+            texture->release();
+            return nullptr;
+        }
+    #if CC_ENABLE_CACHE_TEXTURE_DATA
+        VolatileTexture::addImageTexture(texture, path.c_str(), CCImage::kFmtPng);
+    #endif
+        cache->m_pTextures->setObject(texture, path);
+        texture->release();
+        return texture;
+    }
+
+    // the frames of a plist, or nullptr if its format isn't supported
+    static CCDictionary* framesOf(CCDictionary* dict, std::string const& plist, int& format) {
+        auto metadata = static_cast<CCDictionary*>(dict->objectForKey("metadata"));
+        auto frames = static_cast<CCDictionary*>(dict->objectForKey("frames"));
+        format = metadata ? metadata->valueForKey("format")->intValue() : 0;
+        if (!frames || format < 0 || format > 3) {
+            log::warn("Unsupported spritesheet format in {}", plist);
+            return nullptr;
+        }
+        return frames;
+    }
+
+    static CCSpriteFrame* createFrame(
+        CCDictionary* frameDict, int format, CCTexture2D* texture, std::string const& name
+    ) {
+        auto cache = CCSpriteFrameCache::get();
+        CCSpriteFrame* frame;
+        if (format == 0) {
+            auto rect = CCRectMake(
+                frameDict->valueForKey("x")->floatValue(),
+                frameDict->valueForKey("y")->floatValue(),
+                frameDict->valueForKey("width")->floatValue(),
+                frameDict->valueForKey("height")->floatValue()
+            );
+            auto offset = CCPointMake(
+                frameDict->valueForKey("offsetX")->floatValue(),
+                frameDict->valueForKey("offsetY")->floatValue()
+            );
+            auto size = CCSizeMake(
+                std::abs(frameDict->valueForKey("originalWidth")->intValue()),
+                std::abs(frameDict->valueForKey("originalHeight")->intValue())
+            );
+            frame = CCSpriteFrame::createWithTexture(texture, rect, false, offset, size);
+        }
+        else if (format == 1 || format == 2) {
+            frame = CCSpriteFrame::createWithTexture(
+                texture,
+                CCRectFromString(frameDict->valueForKey("frame")->getCString()),
+                format == 2 && frameDict->valueForKey("rotated")->boolValue(),
+                CCPointFromString(frameDict->valueForKey("offset")->getCString()),
+                CCSizeFromString(frameDict->valueForKey("sourceSize")->getCString())
+            );
+        }
+        else {
+            auto size = CCSizeFromString(frameDict->valueForKey("spriteSize")->getCString());
+            auto rect = CCRectFromString(frameDict->valueForKey("textureRect")->getCString());
+            rect.size = size;
+            auto aliases = static_cast<CCArray*>(frameDict->objectForKey("aliases"));
+            if (aliases && aliases->count()) {
+                auto key = CCString::create(name);
+                for (auto alias : CCArrayExt<CCString*>(aliases)) {
+                    cache->m_pSpriteFramesAliases->setObject(key, alias->getCString());
+                }
+            }
+            frame = CCSpriteFrame::createWithTexture(
+                texture, rect,
+                frameDict->valueForKey("textureRotated")->boolValue(),
+                CCPointFromString(frameDict->valueForKey("spriteOffset")->getCString()),
+                CCSizeFromString(frameDict->valueForKey("spriteSourceSize")->getCString())
+            );
+        }
+        return frame;
+    }
+
+    // same as CCSpriteFrameCache::addSpriteFramesWithDictionary, which is private
+    static void addSpriteFrames(CCDictionary* dict, CCTexture2D* texture, std::string const& plist) {
+        auto cache = CCSpriteFrameCache::get();
+        if (cache->m_pLoadedFileNames->count(plist)) {
+            return;
+        }
+
+        int format;
+        auto frames = framesOf(dict, plist, format);
+        if (!frames) {
+            return;
+        }
+
+        CCDictElement* element;
+        CCDICT_FOREACH(frames, element) {
+            std::string name = element->getStrKey();
+            if (cache->m_pSpriteFrames->objectForKey(name)) {
+                continue;
+            }
+            auto frame = createFrame(
+                static_cast<CCDictionary*>(element->getObject()), format, texture, name
+            );
+            cache->m_pSpriteFrames->setObject(frame, name);
+        }
+        cache->m_pLoadedFileNames->insert(plist);
+    }
+
+    static void upload(Sheet& sheet) {
+        CCTexture2D* texture = nullptr;
+        if (sheet.image && sheet.frames) {
+            texture = addTexture(sheet.image, sheet.pngPath);
+        }
+        if (texture) {
+            addSpriteFrames(sheet.frames, texture, sheet.plist);
+        }
+        else {
+            // let cocos try (and log) it the usual way
+            log::warn("Unable to decode {} off the main thread", sheet.pngPath);
+            CCTextureCache::get()->addImage(sheet.png.c_str(), false);
+            CCSpriteFrameCache::get()->addSpriteFramesWithFile(sheet.plist.c_str());
+        }
+        CC_SAFE_RELEASE_NULL(sheet.image);
+        CC_SAFE_RELEASE_NULL(sheet.frames);
+    }
+};
+
+std::shared_ptr<SpritesheetBatch> Loader::Impl::collectResources(bool forceReload) {
+    auto batch = std::make_shared<SpritesheetBatch>();
+    log::debug("Adding resources");
+    log::pushNest();
+    for (auto const& [_, mod] : m_mods) {
+        if (!forceReload && ModImpl::getImpl(mod)->m_resourcesLoaded)
+            continue;
+        this->updateModResources(mod, *batch);
+        ModImpl::getImpl(mod)->m_resourcesLoaded = true;
+    }
+    log::popNest();
+    return batch;
+}
+
+void Loader::Impl::updateModResources(Mod* mod, SpritesheetBatch& batch) {
     if (mod != Mod::get()) {
         // geode.loader resource is stored somewhere else, which is already added anyway
         auto searchPathRoot = dirs::getModRuntimeDir() / mod->getID() / "resources";
@@ -217,22 +462,301 @@ void Loader::Impl::updateModResources(Mod* mod) {
         auto plist = sheet + ".plist";
         auto ccfu = CCFileUtils::get();
 
-        if (png == std::string(ccfu->fullPathForFilename(png.c_str(), false)) ||
-            plist == std::string(ccfu->fullPathForFilename(plist.c_str(), false))) {
+        std::string pngPath = ccfu->fullPathForFilename(png.c_str(), false);
+        std::string plistPath = ccfu->fullPathForFilename(plist.c_str(), false);
+
+        if (png == pngPath || plist == plistPath) {
             log::warn(
                 R"(The resource dir of "{}" is missing "{}" png and/or plist files)",
                 mod->getID(), sheet
             );
         }
         else {
-            CCTextureCache::get()->addImage(png.c_str(), false);
-            CCSpriteFrameCache::get()->addSpriteFramesWithFile(plist.c_str());
+            auto& load = batch.sheets.emplace_back();
+            load.png = std::move(png);
+            load.plist = std::move(plist);
+            load.pngPath = std::move(pngPath);
+            load.plistPath = std::move(plistPath);
         }
     }
 
     log::popNest();
 }
 
+// same as what CCTextureCache::addImage picks, as that's how the texture 
+// was originally loaded
+static std::optional<CCImage::EImageFormat> imageFormatFor(std::string const& path) {
+    auto const ext = utils::string::toLower(ghc::filesystem::path(path).extension().string());
+    if (ext == ".pvr" || ext == ".pkm" || ext == ".ccz") {
+        // compressed textures aren't loaded through CCImage
+        return std::nullopt;
+    }
+    if (ext == ".jpg" || ext == ".jpeg") {
+        return CCImage::kFmtJpg;
+    }
+    if (ext == ".tif" || ext == ".tiff") {
+        return CCImage::kFmtTiff;
+    }
+    if (ext == ".webp") {
+        return CCImage::kFmtWebp;
+    }
+    return CCImage::kFmtPng;
+}
+
+// the GL texture is recreated on reload, which resets its filtering and 
+// wrapping to the defaults
+static ccTexParams getTexParams(CCTexture2D* texture) {
+    GLint minFilter, magFilter, wrapS, wrapT;
+    ccGLBindTexture2D(texture->getName());
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &minFilter);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &magFilter);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &wrapS);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, &wrapT);
+    return {
+        static_cast<GLuint>(minFilter), static_cast<GLuint>(magFilter),
+        static_cast<GLuint>(wrapS), static_cast<GLuint>(wrapT)
+    };
+}
+
+static void restoreTexParams(CCTexture2D* texture, ccTexParams params, bool hadMipmaps) {
+    auto const isPOT = [](unsigned int n) { return n && !(n & (n - 1)); };
+    auto const pot = isPOT(texture->getPixelsWide()) && isPOT(texture->getPixelsHigh());
+    // the new image may not be a power of two, which mipmaps and repeating 
+    // need
+    if (hadMipmaps && pot) {
+        texture->generateMipmap();
+    }
+    if (!texture->hasMipmaps()) {
+        if (params.minFilter == GL_NEAREST_MIPMAP_NEAREST || params.minFilter == GL_NEAREST_MIPMAP_LINEAR) {
+            params.minFilter = GL_NEAREST;
+        }
+        else if (params.minFilter == GL_LINEAR_MIPMAP_NEAREST || params.minFilter == GL_LINEAR_MIPMAP_LINEAR) {
+            params.minFilter = GL_LINEAR;
+        }
+    }
+    if (!pot) {
+        params.wrapS = GL_CLAMP_TO_EDGE;
+        params.wrapT = GL_CLAMP_TO_EDGE;
+    }
+    texture->setTexParameters(&params);
+}
+
+// the texture a sheet's plist points to, for sheets none of whose frames 
+// were loaded before
+static CCTexture2D* textureForSheet(CCDictionary* dict, std::string const& plistPath) {
+    std::string texturePath;
+    if (auto metadata = static_cast<CCDictionary*>(dict->objectForKey("metadata"))) {
+        texturePath = metadata->valueForKey("textureFileName")->getCString();
+    }
+    if (!texturePath.empty()) {
+        texturePath = CCFileUtils::get()->fullPathFromRelativeFile(texturePath.c_str(), plistPath.c_str());
+    }
+    else {
+        texturePath = plistPath.substr(0, plistPath.rfind('.')) + ".png";
+    }
+    return CCTextureCache::get()->addImage(texturePath.c_str(), false);
+}
+
+size_t Loader::Impl::reloadChangedTextures(utils::MiniFunction<void()> const& changeSearchPaths) {
+    auto fileUtils = CCFileUtils::get();
+    auto textureCache = CCTextureCache::get();
+    auto frameCache = CCSpriteFrameCache::get();
+
+    // the texture cache is keyed by full path, so recover the name each 
+    // texture was looked up with by stripping the search path it came from
+    struct CachedTexture {
+        std::string key;
+        std::string name;
+        CCTexture2D* texture;
+    };
+    std::vector<std::string> prefixes;
+    for (auto const& path : fileUtils->getSearchPaths()) {
+        for (auto const& resolution : fileUtils->getSearchResolutionsOrder()) {
+            prefixes.push_back(std::string(path) + std::string(resolution));
+        }
+    }
+    std::vector<CachedTexture> textures;
+    CCDictElement* element;
+    CCDICT_FOREACH(textureCache->m_pTextures, element) {
+        std::string key = element->getStrKey();
+        size_t longest = 0;
+        for (auto const& prefix : prefixes) {
+            if (prefix.size() > longest && key.starts_with(prefix)) {
+                longest = prefix.size();
+            }
+        }
+        if (longest) {
+            textures.push_back({
+                key, key.substr(longest), static_cast<CCTexture2D*>(element->getObject())
+            });
+        }
+    }
+
+    std::vector<std::pair<std::string, std::string>> plists;
+    for (auto const& plist : *frameCache->m_pLoadedFileNames) {
+        plists.emplace_back(plist, fileUtils->fullPathForFilename(plist.c_str(), false));
+    }
+
+    changeSearchPaths();
+    fileUtils->purgeCachedEntries();
+
+    size_t reloaded = 0;
+
+    // textures are reinitialized in place so everything holding on to them 
+    // picks up the new image
+    std::unordered_map<CCTexture2D*, CCSize> oldSizes;
+    for (auto& [key, name, texture] : textures) {
+        std::string path;
+        for (auto const& searchPath : fileUtils->getSearchPaths()) {
+            for (auto const& resolution : fileUtils->getSearchResolutionsOrder()) {
+                auto full = std::string(searchPath) + std::string(resolution) + name;
+                if (fileUtils->isFileExist(full)) {
+                    path = std::move(full);
+                    break;
+                }
+            }
+            if (!path.empty()) break;
+        }
+        if (path.empty() || path == key) {
+            continue;
+        }
+
+        auto format = imageFormatFor(path);
+        if (!format) {
+            log::warn("Unable to reload texture {}, compressed textures can't be reloaded", path);
+            continue;
+        }
+        auto image = new CCImage();
+        if (!image->initWithImageFileThreadSafe(path.c_str(), *format)) {
+            log::warn("Unable to reload texture {}", path);
+            image->release();
+            continue;
+        }
+        auto oldSize = texture->getContentSize();
+        auto oldParams = getTexParams(texture);
+        auto hadMipmaps = texture->hasMipmaps();
+        texture->releaseGLTexture();
+        bool ok = texture->initWithImage(image);
+        image->release();
+        if (!ok) {
+            log::warn("Unable to reload texture {}", path);
+            continue;
+        }
+        restoreTexParams(texture, oldParams, hadMipmaps);
+        oldSizes.emplace(texture, oldSize);
+
+        texture->retain();
+        textureCache->m_pTextures->removeObjectForKey(key);
+        textureCache->m_pTextures->setObject(texture, path);
+        texture->release();
+    #if CC_ENABLE_CACHE_TEXTURE_DATA
+        VolatileTexture::addImageTexture(texture, path.c_str(), *format);
+    #endif
+        reloaded += 1;
+    }
+
+    // frames are patched in place too, but sprites copy the frame's rect 
+    // when it's set, so remember what they looked like before
+    using FrameKey = std::tuple<CCTexture2D*, float, float, float, float, bool>;
+    std::map<FrameKey, CCSpriteFrame*> movedFrames;
+    for (auto const& [plist, oldPath] : plists) {
+        std::string path = fileUtils->fullPathForFilename(plist.c_str(), false);
+        if (path == oldPath) {
+            continue;
+        }
+        auto dict = CCDictionary::createWithContentsOfFileThreadSafe(path.c_str());
+        if (!dict) {
+            log::warn("Unable to reload sprite sheet {}", path);
+            continue;
+        }
+        int format;
+        if (auto frames = SpritesheetBatch::framesOf(dict, plist, format)) {
+            // frames that are new in this sheet go on the texture the old 
+            // ones use, which has already been reloaded above
+            CCTexture2D* sheetTexture = nullptr;
+            CCDictElement* frameElement;
+            CCDICT_FOREACH(frames, frameElement) {
+                auto frame = static_cast<CCSpriteFrame*>(
+                    frameCache->m_pSpriteFrames->objectForKey(frameElement->getStrKey())
+                );
+                if (frame) {
+                    sheetTexture = frame->getTexture();
+                    break;
+                }
+            }
+            if (!sheetTexture) {
+                sheetTexture = textureForSheet(dict, path);
+            }
+            CCDICT_FOREACH(frames, frameElement) {
+                std::string name = frameElement->getStrKey();
+                auto frame = static_cast<CCSpriteFrame*>(frameCache->m_pSpriteFrames->objectForKey(name));
+                if (!frame) {
+                    if (sheetTexture) {
+                        frameCache->m_pSpriteFrames->setObject(SpritesheetBatch::createFrame(
+                            static_cast<CCDictionary*>(frameElement->getObject()), format, sheetTexture, name
+                        ), name);
+                    }
+                    continue;
+                }
+                auto updated = SpritesheetBatch::createFrame(
+                    static_cast<CCDictionary*>(frameElement->getObject()), format, frame->getTexture(), name
+                );
+                auto const& rect = frame->getRect();
+                movedFrames.emplace(
+                    FrameKey(
+                        frame->getTexture(), rect.origin.x, rect.origin.y,
+                        rect.size.width, rect.size.height, frame->isRotated()
+                    ),
+                    frame
+                );
+                frame->setRectInPixels(updated->getRectInPixels());
+                frame->setRotated(updated->isRotated());
+                frame->setOffsetInPixels(updated->getOffsetInPixels());
+                frame->setOriginalSizeInPixels(updated->getOriginalSizeInPixels());
+                frame->setOriginalSize(updated->getOriginalSize());
+            }
+            reloaded += 1;
+        }
+        dict->release();
+    }
+
+    // update the sprites in the running scene that use a patched frame or 
+    // show a whole reloaded texture
+    if (reloaded) {
+        std::vector<CCNode*> nodes;
+        if (auto scene = CCDirector::get()->getRunningScene()) {
+            nodes.push_back(scene);
+        }
+        while (!nodes.empty()) {
+            auto node = nodes.back();
+            nodes.pop_back();
+            for (auto child : CCArrayExt<CCNode*>(node->getChildren())) {
+                nodes.push_back(child);
+            }
+            auto sprite = typeinfo_cast<CCSprite*>(node);
+            if (!sprite || !sprite->getTexture()) {
+                continue;
+            }
+            auto const& rect = sprite->getTextureRect();
+            auto frame = movedFrames.find(FrameKey(
+                sprite->getTexture(), rect.origin.x, rect.origin.y,
+                rect.size.width, rect.size.height, sprite->isTextureRectRotated()
+            ));
+            if (frame != movedFrames.end()) {
+                sprite->setDisplayFrame(frame->second);
+                continue;
+            }
+            auto size = oldSizes.find(sprite->getTexture());
+            if (size != oldSizes.end() && rect.equals(CCRect(CCPointZero, size->second))) {
+                sprite->setTextureRect(CCRect(CCPointZero, sprite->getTexture()->getContentSize()));
+            }
+        }
+    }
+
+    log::debug("Reloaded {} textures and sprite sheets", reloaded);
+    return reloaded;
+}
+
 // Dependencies and refreshing
 
 void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
@@ -240,7 +764,7 @@ void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
         log::debug("Searching {}", dir);
         log::pushNest();
         for (auto const& entry : ghc::filesystem::directory_iterator(dir)) {
-            if (!ghc::filesystem::is_regular_file(entry) ||
+            if (!entry.is_regular_file() ||
                 entry.path().extension() != GEODE_MOD_EXTENSION)
                 continue;
 
@@ -249,7 +773,7 @@ void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
 
             auto res = ModMetadata::createFromGeodeFile(entry.path());
             if (!res) {
-                m_problems.push_back({
+                this->addProblem({
                     LoadProblem::Type::InvalidFile,
                     entry.path(),
                     res.unwrapErr()
@@ -267,7 +791,7 @@ void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
             if (std::find_if(modQueue.begin(), modQueue.end(), [&](auto& item) {
                     return modMetadata.getID() == item.getID();
                 }) != modQueue.end()) {
-                m_problems.push_back({
+                this->addProblem({
                     LoadProblem::Type::Duplicate,
                     modMetadata,
                     "A mod with the same ID is already present."
@@ -304,7 +828,7 @@ void Loader::Impl::populateModList(std::vector<ModMetadata>& modQueue) {
 
         auto res = mod->m_impl->setup();
         if (!res) {
-            m_problems.push_back({
+            this->addProblem({
                 LoadProblem::Type::SetupFailed,
                 mod,
                 res.unwrapErr()
@@ -322,16 +846,14 @@ void Loader::Impl::populateModList(std::vector<ModMetadata>& modQueue) {
 
 void Loader::Impl::buildModGraph() {
     for (auto const& [id, mod] : m_mods) {
-        log::debug("{}", mod->getID());
-        log::pushNest();
         for (auto& dependency : mod->m_impl->m_metadata.m_impl->m_dependencies) {
-            log::debug("{}", dependency.id);
-            if (!m_mods.contains(dependency.id)) {
+            auto it = m_mods.find(dependency.id);
+            if (it == m_mods.end()) {
                 dependency.mod = nullptr;
                 continue;
             }
 
-            dependency.mod = m_mods[dependency.id];
+            dependency.mod = it->second;
 
             if (!dependency.version.compare(dependency.mod->getVersion())) {
                 dependency.mod = nullptr;
@@ -344,10 +866,9 @@ void Loader::Impl::buildModGraph() {
             dependency.mod->m_impl->m_dependants.push_back(mod);
         }
         for (auto& incompatibility : mod->m_impl->m_metadata.m_impl->m_incompatibilities) {
-            incompatibility.mod =
-                m_mods.contains(incompatibility.id) ? m_mods[incompatibility.id] : nullptr;
+            auto it = m_mods.find(incompatibility.id);
+            incompatibility.mod = it != m_mods.end() ? it->second : nullptr;
         }
-        log::popNest();
     }
 }
 
@@ -393,7 +914,7 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
             log::debug("Load");
             auto res = node->m_impl->loadBinary();
             if (!res) {
-                m_problems.push_back({
+                this->addProblem({
                     LoadProblem::Type::LoadFailed,
                     node,
                     res.unwrapErr()
@@ -417,7 +938,7 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
     if (early) {
         auto res = unzipFunction();
         if (!res) {
-            m_problems.push_back({
+            this->addProblem({
                 LoadProblem::Type::UnzipFailed,
                 node,
                 res.unwrapErr()
@@ -430,109 +951,161 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
         loadFunction();
     }
     else {
-        std::thread([=]() {
-            auto res = unzipFunction();
-            queueInMainThread([=, this]() {
-                if (!res) {
-                    m_problems.push_back({
-                        LoadProblem::Type::UnzipFailed,
-                        node,
-                        res.unwrapErr()
-                    });
-                    log::error("Failed to unzip: {}", res.unwrapErr());
-                    log::popNest();
-                    m_refreshingModCount -= 1;
-                    return;
-                }
-                loadFunction();
-            });
-        }).detach();
+        utils::thread::async(unzipFunction).then([=, this](Result<> const& res) {
+            if (!res) {
+                this->addProblem({
+                    LoadProblem::Type::UnzipFailed,
+                    node,
+                    res.unwrapErr()
+                });
+                log::error("Failed to unzip: {}", res.unwrapErr());
+                log::popNest();
+                m_refreshingModCount -= 1;
+                return;
+            }
+            loadFunction();
+        }, utils::thread::RunOn::MainThread);
+    }
+}
+
+// Problems found by findProblems, which are the only ones that can change 
+// after startup
+static bool isGraphProblem(LoadProblem::Type type) {
+    switch (type) {
+        case LoadProblem::Type::Unknown:
+        case LoadProblem::Type::Suggestion:
+        case LoadProblem::Type::Recommendation:
+        case LoadProblem::Type::Conflict:
+        case LoadProblem::Type::MissingDependency:
+        case LoadProblem::Type::PresentIncompatibility:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void Loader::Impl::addProblem(LoadProblem problem) {
+    m_problemCounts[static_cast<size_t>(problem.type)] += 1;
+    m_problemCount += 1;
+    m_problemsCache.reset();
+    auto const order = m_nextProblemOrder++;
+    if (auto mod = std::get_if<Mod*>(&problem.cause)) {
+        m_modProblems[(*mod)->getID()].push_back({ order, std::move(problem) });
+    }
+    else if (auto metadata = std::get_if<ModMetadata>(&problem.cause)) {
+        m_modProblems[metadata->getID()].push_back({ order, std::move(problem) });
+    }
+    else {
+        m_problems.push_back({ order, std::move(problem) });
     }
 }
 
 void Loader::Impl::findProblems() {
     for (auto const& [id, mod] : m_mods) {
-        if (!mod->shouldLoad()) {
-            log::debug("{} is not enabled", id);
+        this->findProblems(mod);
+    }
+}
+
+void Loader::Impl::findProblems(Mod* mod) {
+    auto id = mod->getID();
+    auto const action = mod->getRequestedAction();
+    if (!mod->shouldLoad() ||
+        action == ModRequestedAction::Uninstall ||
+        action == ModRequestedAction::UninstallWithSaveData) {
+        return;
+    }
+
+    for (auto const& dep : mod->getMetadata().getDependencies()) {
+        if (dep.mod && dep.mod->isEnabled() && dep.version.compare(dep.mod->getVersion()))
             continue;
+        switch(dep.importance) {
+            case ModMetadata::Dependency::Importance::Suggested:
+                this->addProblem({
+                    LoadProblem::Type::Suggestion,
+                    mod,
+                    fmt::format("{} {}", dep.id, dep.version.toString())
+                });
+                log::info("{} suggests {} {}", id, dep.id, dep.version);
+                break;
+            case ModMetadata::Dependency::Importance::Recommended:
+                this->addProblem({
+                    LoadProblem::Type::Recommendation,
+                    mod,
+                    fmt::format("{} {}", dep.id, dep.version.toString())
+                });
+                log::warn("{} recommends {} {}", id, dep.id, dep.version);
+                break;
+            case ModMetadata::Dependency::Importance::Required:
+                this->addProblem({
+                    LoadProblem::Type::MissingDependency,
+                    mod,
+                    fmt::format("{} {}", dep.id, dep.version.toString())
+                });
+                log::error("{} requires {} {}", id, dep.id, dep.version);
+                break;
         }
-        log::debug("{}", id);
-        log::pushNest();
+    }
 
-        for (auto const& dep : mod->getMetadata().getDependencies()) {
-            if (dep.mod && dep.mod->isEnabled() && dep.version.compare(dep.mod->getVersion()))
-                continue;
-            switch(dep.importance) {
-                case ModMetadata::Dependency::Importance::Suggested:
-                    m_problems.push_back({
-                        LoadProblem::Type::Suggestion,
-                        mod,
-                        fmt::format("{} {}", dep.id, dep.version.toString())
-                    });
-                    log::info("{} suggests {} {}", id, dep.id, dep.version);
-                    break;
-                case ModMetadata::Dependency::Importance::Recommended:
-                    m_problems.push_back({
-                        LoadProblem::Type::Recommendation,
-                        mod,
-                        fmt::format("{} {}", dep.id, dep.version.toString())
-                    });
-                    log::warn("{} recommends {} {}", id, dep.id, dep.version);
-                    break;
-                case ModMetadata::Dependency::Importance::Required:
-                    m_problems.push_back({
-                        LoadProblem::Type::MissingDependency,
-                        mod,
-                        fmt::format("{} {}", dep.id, dep.version.toString())
-                    });
-                    log::error("{} requires {} {}", id, dep.id, dep.version);
-                    break;
-            }
+    for (auto const& dep : mod->getMetadata().getIncompatibilities()) {
+        if (!dep.mod || !dep.version.compare(dep.mod->getVersion()))
+            continue;
+        switch(dep.importance) {
+            case ModMetadata::Incompatibility::Importance::Conflicting:
+                this->addProblem({
+                    LoadProblem::Type::Conflict,
+                    mod,
+                    fmt::format("{} {}", dep.id, dep.version.toString())
+                });
+                log::warn("{} conflicts with {} {}", id, dep.id, dep.version);
+                break;
+            case ModMetadata::Incompatibility::Importance::Breaking:
+                this->addProblem({
+                    LoadProblem::Type::PresentIncompatibility,
+                    mod,
+                    fmt::format("{} {}", dep.id, dep.version.toString())
+                });
+                log::error("{} breaks {} {}", id, dep.id, dep.version);
+                break;
         }
+    }
 
-        for (auto const& dep : mod->getMetadata().getIncompatibilities()) {
-            if (!dep.mod || !dep.version.compare(dep.mod->getVersion()))
-                continue;
-            switch(dep.importance) {
-                case ModMetadata::Incompatibility::Importance::Conflicting:
-                    m_problems.push_back({
-                        LoadProblem::Type::Conflict,
-                        mod,
-                        fmt::format("{} {}", dep.id, dep.version.toString())
-                    });
-                    log::warn("{} conflicts with {} {}", id, dep.id, dep.version);
-                    break;
-                case ModMetadata::Incompatibility::Importance::Breaking:
-                    m_problems.push_back({
-                        LoadProblem::Type::PresentIncompatibility,
-                        mod,
-                        fmt::format("{} {}", dep.id, dep.version.toString())
-                    });
-                    log::error("{} breaks {} {}", id, dep.id, dep.version);
-                    break;
+    // if the mod is not loaded but there are no problems related to it 
+    // (mods that are only going to be enabled on restart aren't loaded yet)
+    auto problems = m_modProblems.find(id);
+    if (!mod->isEnabled() &&
+        action != ModRequestedAction::Enable &&
+        (problems == m_modProblems.end() || problems->second.empty())) {
+        this->addProblem({
+            LoadProblem::Type::Unknown,
+            mod,
+            ""
+        });
+        log::error("{} failed to load for an unknown reason", id);
+    }
+}
+
+void Loader::Impl::refreshModProblems(Mod* mod) {
+    auto it = m_modProblems.find(mod->getID());
+    if (it != m_modProblems.end()) {
+        auto& problems = it->second;
+        for (auto const& [_, problem] : problems) {
+            if (isGraphProblem(problem.type)) {
+                m_problemCounts[static_cast<size_t>(problem.type)] -= 1;
+                m_problemCount -= 1;
             }
         }
-
-        Mod* myEpicMod = mod; // clang fix
-        // if the mod is not loaded but there are no problems related to it
-        if (!mod->isEnabled() &&
-            mod->shouldLoad() &&
-            !std::any_of(m_problems.begin(), m_problems.end(), [myEpicMod](auto& item) {
-                return std::holds_alternative<ModMetadata>(item.cause) &&
-                    std::get<ModMetadata>(item.cause).getID() == myEpicMod->getID() ||
-                    std::holds_alternative<Mod*>(item.cause) &&
-                    std::get<Mod*>(item.cause) == myEpicMod;
-            })) {
-            m_problems.push_back({
-                LoadProblem::Type::Unknown,
-                mod,
-                ""
-            });
-            log::error("{} failed to load for an unknown reason", id);
+        problems.erase(std::remove_if(problems.begin(), problems.end(), [](auto const& entry) {
+            return isGraphProblem(entry.problem.type);
+        }), problems.end());
+        if (problems.empty()) {
+            m_modProblems.erase(it);
         }
-
-        log::popNest();
+        m_problemsCache.reset();
     }
+    // dependencies and incompatibilities only matter for the mod itself, as 
+    // other mods' state can't change until the next launch
+    this->findProblems(mod);
+    crashlog::updateStateSnapshot();
 }
 
 void Loader::Impl::refreshModGraph() {
@@ -548,6 +1121,11 @@ void Loader::Impl::refreshModGraph() {
     auto begin = std::chrono::high_resolution_clock::now();
 
     m_problems.clear();
+    m_modProblems.clear();
+    m_problemCounts.fill(0);
+    m_problemCount = 0;
+    m_nextProblemOrder = 0;
+    m_problemsCache.reset();
 
     m_loadingState = LoadingState::Queue;
     log::debug("Queueing mods");
@@ -569,6 +1147,9 @@ void Loader::Impl::refreshModGraph() {
     this->buildModGraph();
     log::popNest();
 
+    // the mods are known now, and loading them is where crashes happen
+    crashlog::updateStateSnapshot();
+
     m_loadingState = LoadingState::EarlyMods;
     log::debug("Loading early mods");
     log::pushNest();
@@ -629,6 +1210,7 @@ void Loader::Impl::continueRefreshModGraph() {
             log::pushNest();
             this->findProblems();
             log::popNest();
+            crashlog::updateStateSnapshot();
             m_loadingState = LoadingState::Done;
             {
                 auto end = std::chrono::high_resolution_clock::now();
@@ -653,7 +1235,51 @@ void Loader::Impl::continueRefreshModGraph() {
 }
 
 std::vector<LoadProblem> Loader::Impl::getProblems() const {
-    return m_problems;
+    if (!m_problemsCache) {
+        std::vector<OrderedProblem const*> ordered;
+        ordered.reserve(m_problemCount);
+        for (auto const& entry : m_problems) {
+            ordered.push_back(&entry);
+        }
+        for (auto const& [_, modProblems] : m_modProblems) {
+            for (auto const& entry : modProblems) {
+                ordered.push_back(&entry);
+            }
+        }
+        std::sort(ordered.begin(), ordered.end(), [](auto a, auto b) {
+            return a->order < b->order;
+        });
+        std::vector<LoadProblem> problems;
+        problems.reserve(ordered.size());
+        for (auto entry : ordered) {
+            problems.push_back(entry->problem);
+        }
+        m_problemsCache = std::move(problems);
+    }
+    // the cache only saves merging and sorting again, callers still get 
+    // their own copy
+    return *m_problemsCache;
+}
+
+std::vector<LoadProblem> Loader::Impl::getProblems(Mod* mod) const {
+    auto it = m_modProblems.find(mod->getID());
+    if (it == m_modProblems.end()) {
+        return {};
+    }
+    std::vector<LoadProblem> problems;
+    problems.reserve(it->second.size());
+    for (auto const& [_, problem] : it->second) {
+        problems.push_back(problem);
+    }
+    return problems;
+}
+
+size_t Loader::Impl::getProblemCount() const {
+    return m_problemCount;
+}
+
+size_t Loader::Impl::getProblemCount(LoadProblem::Type type) const {
+    return m_problemCounts[static_cast<size_t>(type)];
 }
 
 void Loader::Impl::forceReset() {
@@ -675,6 +1301,13 @@ void Loader::Impl::addUninitializedHook(Hook* hook, Mod* mod) {
     m_uninitializedHooks.emplace_back(hook, mod);
 }
 
+void Loader::Impl::reserveUninitializedHooks(size_t count) {
+    auto const size = m_uninitializedHooks.size() + count;
+    if (m_uninitializedHooks.capacity() < size) {
+        m_uninitializedHooks.reserve(std::max(size, m_uninitializedHooks.capacity() * 2));
+    }
+}
+
 bool Loader::Impl::loadHooks() {
     m_readyToHook = true;
     bool hadErrors = false;
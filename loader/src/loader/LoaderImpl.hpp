@@ -14,6 +14,9 @@
 #include <Geode/utils/MiniFunction.hpp>
 #include "ModImpl.hpp"
 #include <crashlog.hpp>
+#include <array>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <thread>
@@ -25,6 +28,8 @@
 
 // TODO: Find a file convention for impl headers
 namespace geode {
+    struct SpritesheetBatch;
+
     class Loader::Impl {
     public:
         mutable std::mutex m_mutex;
@@ -33,7 +38,23 @@ namespace geode {
         std::optional<bool> m_forwardCompatMode;
 
         std::vector<ghc::filesystem::path> m_modSearchDirectories;
-        std::vector<LoadProblem> m_problems;
+        // problems remember when they were found, so they can still be 
+        // listed in that order after being split up by mod
+        struct OrderedProblem {
+            size_t order;
+            LoadProblem problem;
+        };
+        // problems that can't be tied to a mod ID, such as invalid files
+        std::vector<OrderedProblem> m_problems;
+        // problems of each mod, so a single mod can be rechecked without 
+        // touching the rest
+        std::map<std::string, std::vector<OrderedProblem>> m_modProblems;
+        std::array<size_t, static_cast<size_t>(LoadProblem::Type::UnzipFailed) + 1> m_problemCounts {};
+        size_t m_problemCount = 0;
+        size_t m_nextProblemOrder = 0;
+        // every problem in the order they were found, rebuilt only after a 
+        // problem changes
+        mutable std::optional<std::vector<LoadProblem>> m_problemsCache;
         std::unordered_map<std::string, Mod*> m_mods;
         std::deque<Mod*> m_modsToLoad;
         std::vector<ghc::filesystem::path> m_texturePaths;
@@ -79,7 +100,8 @@ namespace geode {
 
         void createDirectories();
 
-        void updateModResources(Mod* mod);
+        void updateModResources(Mod* mod, SpritesheetBatch& batch);
+        std::shared_ptr<SpritesheetBatch> collectResources(bool forceReload);
         void addSearchPaths();
         void addNativeBinariesPath(ghc::filesystem::path const& path);
 
@@ -98,7 +120,14 @@ namespace geode {
         void populateModList(std::vector<ModMetadata>& modQueue);
         void buildModGraph();
         void loadModGraph(Mod* node, bool early);
+        void addProblem(LoadProblem problem);
         void findProblems();
+        void findProblems(Mod* mod);
+        /**
+         * Re-check a single mod's dependencies and incompatibilities after 
+         * its requested action changed
+         */
+        void refreshModProblems(Mod* mod);
         void refreshModGraph();
         void continueRefreshModGraph();
 
@@ -108,14 +137,33 @@ namespace geode {
         Mod* getLoadedMod(std::string const& id) const;
         std::vector<Mod*> getAllMods();
         std::vector<LoadProblem> getProblems() const;
+        std::vector<LoadProblem> getProblems(Mod* mod) const;
+        size_t getProblemCount() const;
+        size_t getProblemCount(LoadProblem::Type type) const;
 
         void updateResources(bool forceReload);
+        /**
+         * Decode all mods' spritesheets on worker threads. Textures are
+         * uploaded on the main thread in the same order updateResources
+         * would, calling onProgress with (decoded, total) along the way
+         */
+        void updateResourcesAsync(
+            bool forceReload,
+            utils::MiniFunction<void(size_t, size_t)> onProgress,
+            utils::MiniFunction<void()> onFinished
+        );
+        /**
+         * Reload only the textures and sprite sheets whose files resolve 
+         * elsewhere after changeSearchPaths has run, patching them in place
+         */
+        size_t reloadChangedTextures(utils::MiniFunction<void()> const& changeSearchPaths);
 
         void queueInMainThread(const ScheduledFunction& func);
         void executeMainThreadQueue();
 
         bool isReadyToHook() const;
         void addUninitializedHook(Hook* hook, Mod* mod);
+        void reserveUninitializedHooks(size_t count);
 
         Mod* getInternalMod();
         Result<> setupInternalMod();
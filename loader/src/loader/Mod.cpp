@@ -121,6 +121,10 @@ Result<Hook*> Mod::claimHook(std::shared_ptr<Hook> hook) {
     return m_impl->claimHook(hook);
 }
 
+Result<> Mod::claimHooks(std::vector<std::shared_ptr<Hook>> const& hooks) {
+    return m_impl->claimHooks(hooks);
+}
+
 Result<> Mod::disownHook(Hook* hook) {
     return m_impl->disownHook(hook);
 }
@@ -4,6 +4,7 @@
 #include "HookImpl.hpp"
 #include "PatchImpl.hpp"
 #include "about.hpp"
+#include "AllocationTracker.hpp"
 #include "console.hpp"
 
 #include <hash/hash.hpp>
@@ -361,7 +362,6 @@ Result<> Mod::Impl::loadBinary() {
 
     LoaderImpl::get()->releaseNextMod();
 
-
     ModStateEvent(m_self, ModEventType::Loaded).post();
     ModStateEvent(m_self, ModEventType::Enabled).post();
 
@@ -375,6 +375,7 @@ Result<> Mod::Impl::enable() {
 
     m_requestedAction = ModRequestedAction::Enable;
     Mod::get()->setSavedValue("should-load-" + m_metadata.getID(), true);
+    LoaderImpl::get()->refreshModProblems(m_self);
 
     return Ok();
 }
@@ -386,6 +387,7 @@ Result<> Mod::Impl::disable() {
 
     m_requestedAction = ModRequestedAction::Disable;
     Mod::get()->setSavedValue("should-load-" + m_metadata.getID(), false);
+    LoaderImpl::get()->refreshModProblems(m_self);
 
     return Ok();
 }
@@ -404,6 +406,7 @@ Result<> Mod::Impl::uninstall(bool deleteSaveData) {
     m_requestedAction = deleteSaveData ?
         ModRequestedAction::UninstallWithSaveData :
         ModRequestedAction::Uninstall;
+    LoaderImpl::get()->refreshModProblems(m_self);
 
     std::error_code ec;
     ghc::filesystem::remove(m_metadata.getPath(), ec);
@@ -492,6 +495,29 @@ Result<Hook*> Mod::Impl::claimHook(std::shared_ptr<Hook> hook) {
     return Ok(ptr);
 }
 
+Result<> Mod::Impl::claimHooks(std::vector<std::shared_ptr<Hook>> const& hooks) {
+    // keep growing geometrically, every $modify class claims its hooks separately
+    if (m_hooks.capacity() < m_hooks.size() + hooks.size()) {
+        m_hooks.reserve(std::max(m_hooks.size() + hooks.size(), m_hooks.capacity() * 2));
+    }
+    if (!LoaderImpl::get()->isReadyToHook()) {
+        LoaderImpl::get()->reserveUninitializedHooks(hooks.size());
+    }
+
+    std::string errors;
+    for (auto const& hook : hooks) {
+        auto res = this->claimHook(hook);
+        if (!res) {
+            if (!errors.empty()) errors += "\n";
+            errors += fmt::format("{}: {}", hook->getDisplayName(), res.unwrapErr());
+        }
+    }
+    if (!errors.empty()) {
+        return Err(std::move(errors));
+    }
+    return Ok();
+}
+
 Result<> Mod::Impl::disownHook(Hook* hook) {
     if (hook->getOwner() != m_self) {
         return Err("Cannot disown hook not owned by this mod");
@@ -672,8 +698,32 @@ ModJson Mod::Impl::getRuntimeInfo() const {
 
     auto obj = matjson::Object();
     obj["hooks"] = matjson::Array();
+    double calls = 0, inclusive = 0, exclusive = 0;
     for (auto hook : m_hooks) {
-        obj["hooks"].as_array().push_back(ModJson(hook->getRuntimeInfo()));
+        auto info = hook->getRuntimeInfo();
+        if (info.contains("profile")) {
+            calls += info["profile"]["calls"].as_double();
+            inclusive += info["profile"]["inclusive-ms"].as_double();
+            exclusive += info["profile"]["exclusive-ms"].as_double();
+        }
+        obj["hooks"].as_array().push_back(ModJson(info));
+    }
+    if (hook::isProfilingEnabled()) {
+        auto stats = matjson::Object();
+        stats["calls"] = calls;
+        stats["inclusive-ms"] = inclusive;
+        stats["exclusive-ms"] = exclusive;
+        obj["profile"] = stats;
+    }
+    if (auto tracker = getModAllocationTracker()) {
+        auto stats = tracker->getStats(m_self);
+        auto memory = matjson::Object();
+        memory["live-bytes"] = stats.liveBytes;
+        memory["live-allocations"] = stats.liveAllocations;
+        memory["total-allocations"] = stats.totalAllocations;
+        memory["sampled-allocations"] = static_cast<double>(stats.sampledAllocations);
+        memory["sample-interval"] = static_cast<double>(tracker->getSampleInterval());
+        obj["memory"] = memory;
     }
     obj["patches"] = matjson::Array();
     for (auto patch : m_patches) {
@@ -114,6 +114,7 @@ namespace geode {
         void registerCustomSetting(std::string_view const key, std::unique_ptr<SettingValue> value);
 
         Result<Hook*> claimHook(std::shared_ptr<Hook> hook);
+        Result<> claimHooks(std::vector<std::shared_ptr<Hook>> const& hooks);
         Result<> disownHook(Hook* hook);
         [[nodiscard]] std::vector<Hook*> getHooks() const;
 
@@ -1,50 +1,8 @@
 #include <Geode/c++stl/gdstdlib.hpp>
 #include "../../c++stl/string-impl.hpp"
 #include "internalString.hpp"
-
-#if defined(GEODE_IS_ANDROID32)
-static auto constexpr NEW_SYM = "_Znwj";
-#elif defined(GEODE_IS_ANDROID64)
-static auto constexpr NEW_SYM = "_Znwm";
-#endif
-
-static auto constexpr DELETE_SYM = "_ZdlPv";
-
-static void* getLibHandle() {
-    static void* handle = dlopen("libcocos2dcpp.so", RTLD_LAZY | RTLD_NOLOAD);
-    return handle;
-}
-
-namespace geode::base {
-    uintptr_t get() {
-        static std::uintptr_t basePtr = 0u;
-        if (basePtr == 0u) {
-            auto handle = getLibHandle();
-
-            // JNI_OnLoad is present on all versions of GD
-            auto sym = dlsym(handle, "JNI_OnLoad");
-            assert(sym != nullptr);
-
-            Dl_info p;
-            auto dlAddrRes = dladdr(sym, &p);
-            assert(dlAddrRes != 0);
-
-            basePtr = reinterpret_cast<std::uintptr_t>(p.dli_fbase);
-        }
-
-        return basePtr;
-    }
-}
-
-void* gd::operatorNew(size_t size) {
-    static auto fnPtr = reinterpret_cast<void*(*)(size_t)>(dlsym(getLibHandle(), NEW_SYM));
-    return fnPtr(size);
-}
-
-void gd::operatorDelete(void* ptr) {
-    static auto fnPtr = reinterpret_cast<void(*)(void*)>(dlsym(getLibHandle(), DELETE_SYM));
-    return fnPtr(ptr);
-}
+#include <algorithm>
+#include <cstring>
 
 using namespace geode::stl;
 
@@ -89,10 +47,18 @@ namespace geode::stl {
 
         if (data.m_data[-1].m_refcount <= 0) {
             gd::operatorDelete(&data.m_data[-1]);
-            data.m_data = nullptr; 
         } else {
             --data.m_data[-1].m_refcount;
         }
+        // we no longer own a reference either way, so make sure
+        // freeing twice doesnt decrement someone else's refcount
+        data.m_data = nullptr;
+    }
+
+    void StringImpl::moveFrom(StringData& other) {
+        // just take over the reference, refcount stays the same
+        data.m_data = other.m_data;
+        StringImpl{other}.setEmpty();
     }
 
     char* StringImpl::getStorage() {
@@ -122,11 +88,35 @@ namespace geode::stl {
         this->getStorage()[str.size()] = 0;
     }
 
+    void StringImpl::reserve(size_t cap) {
+        auto const size = this->getSize();
+        cap = std::max(cap, size);
+
+        // a refcount of 0 means we're the only owner (-1 is unshareable, but still unique)
+        bool const unique = data.m_data != emptyInternalString() && data.m_data[-1].m_refcount <= 0;
+        if (unique && this->getCapacity() >= cap) return;
+        // the empty rep is fine as long as nothing needs to be written
+        if (cap == 0) return;
+
+        StringData::Internal internal;
+        internal.m_size = size;
+        internal.m_capacity = cap;
+        internal.m_refcount = 0;
+
+        auto* buffer = static_cast<char*>(gd::operatorNew(cap + 1 + sizeof(internal)));
+        std::memcpy(buffer, &internal, sizeof(internal));
+        std::memcpy(buffer + sizeof(internal), this->getStorage(), size + 1);
+        this->free();
+        data.m_data = reinterpret_cast<StringData::Internal*>(buffer + sizeof(internal));
+    }
+
     size_t StringImpl::getSize() {
         return data.m_data[-1].m_size;
     }
     void StringImpl::setSize(size_t size) {
-        // TODO: implement this, remember its copy-on-write...
+        // copy-on-write, so this is only valid after reserve made the storage unique
+        if (data.m_data == emptyInternalString()) return;
+        data.m_data[-1].m_size = size;
     }
 
     size_t StringImpl::getCapacity() {
@@ -306,3 +306,47 @@ void geode::utils::game::restart() {
         nullptr
     ), CCDirector::get()->getRunningScene(), false);
 }
+
+#if defined(GEODE_IS_ANDROID32)
+static auto constexpr NEW_SYM = "_Znwj";
+#elif defined(GEODE_IS_ANDROID64)
+static auto constexpr NEW_SYM = "_Znwm";
+#endif
+
+static auto constexpr DELETE_SYM = "_ZdlPv";
+
+static void* getLibHandle() {
+    static void* handle = dlopen("libcocos2dcpp.so", RTLD_LAZY | RTLD_NOLOAD);
+    return handle;
+}
+
+namespace geode::base {
+    uintptr_t get() {
+        static std::uintptr_t basePtr = 0u;
+        if (basePtr == 0u) {
+            auto handle = getLibHandle();
+
+            // JNI_OnLoad is present on all versions of GD
+            auto sym = dlsym(handle, "JNI_OnLoad");
+            assert(sym != nullptr);
+
+            Dl_info p;
+            auto dlAddrRes = dladdr(sym, &p);
+            assert(dlAddrRes != 0);
+
+            basePtr = reinterpret_cast<std::uintptr_t>(p.dli_fbase);
+        }
+
+        return basePtr;
+    }
+}
+
+void* gd::operatorNew(size_t size) {
+    static auto fnPtr = reinterpret_cast<void*(*)(size_t)>(dlsym(getLibHandle(), NEW_SYM));
+    return fnPtr(size);
+}
+
+void gd::operatorDelete(void* ptr) {
+    static auto fnPtr = reinterpret_cast<void(*)(void*)>(dlsym(getLibHandle(), DELETE_SYM));
+    return fnPtr(ptr);
+}
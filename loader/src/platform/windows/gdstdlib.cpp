@@ -9,10 +9,17 @@ namespace geode::stl {
 
     void StringImpl::free() {
         if (data.m_capacity > 15) {
-            delete data.m_bigStorage;
+            operator delete(data.m_bigStorage);
         }
     }
 
+    void StringImpl::moveFrom(StringData& other) {
+        // the small storage lives inline and the big storage is a plain
+        // heap pointer, so the whole thing can just be copied over
+        data = other;
+        StringImpl{other}.setEmpty();
+    }
+
     char* StringImpl::getStorage() {
         return data.m_capacity <= 15 ? data.m_smallStorage.data() : data.m_bigStorage;
     }
@@ -23,10 +30,23 @@ namespace geode::stl {
         } else {
             data.m_bigStorage = static_cast<char*>(operator new(str.size() + 1));
         }
-        std::memcpy(getStorage(), str.data(), str.size());
+        // an empty view may not point anywhere
+        if (str.size() != 0) {
+            std::memcpy(getStorage(), str.data(), str.size());
+        }
         getStorage()[str.size()] = 0;
     }
 
+    void StringImpl::reserve(size_t cap) {
+        if (cap <= data.m_capacity) return;
+
+        auto* buffer = static_cast<char*>(operator new(cap + 1));
+        std::memcpy(buffer, getStorage(), data.m_size + 1);
+        this->free();
+        data.m_bigStorage = buffer;
+        data.m_capacity = cap;
+    }
+
     size_t StringImpl::getSize() {
         return data.m_size;
     }
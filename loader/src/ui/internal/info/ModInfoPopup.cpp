@@ -351,7 +351,10 @@ LocalModInfoPopup::LocalModInfoPopup()
 
 
 bool LocalModInfoPopup::init(Mod* mod, ModListLayer* list) {
-    m_item = Index::get()->getMajorItem(mod->getMetadata().getID());
+    auto updateStatus = Index::get()->getUpdateStatus(mod->getMetadata().getID());
+    m_item = updateStatus ?
+        updateStatus->latestMajor :
+        Index::get()->getMajorItem(mod->getMetadata().getID());
     if (m_item)
         m_installListener.setFilter(m_item->getMetadata().getID());
     m_mod = mod;
@@ -424,7 +427,7 @@ bool LocalModInfoPopup::init(Mod* mod, ModListLayer* list) {
         m_buttonMenu->addChild(uninstallBtn);
 
         // todo: show update button on loader that invokes the installer
-        if (m_item && Index::get()->isUpdateAvailable(m_item)) {
+        if (m_item && updateStatus && updateStatus->updateAvailable) {
             m_installBtnSpr = IconButtonSprite::create(
                 "GE_button_01.png"_spr,
                 CCSprite::createWithSpriteFrameName("install.png"_spr),
@@ -442,14 +445,11 @@ bool LocalModInfoPopup::init(Mod* mod, ModListLayer* list) {
             m_installStatus->setVisible(false);
             m_mainLayer->addChild(m_installStatus);
 
-            auto minorIndexItem = Index::get()->getItem(
-                mod->getMetadata().getID(),
-                ComparableVersionInfo(mod->getMetadata().getVersion(), VersionCompare::MoreEq)
-            );
+            auto minorIndexItem = updateStatus->latestCompatible;
 
             // TODO: use column layout here?
 
-            if (m_item->getMetadata().getVersion().getMajor() > minorIndexItem->getMetadata().getVersion().getMajor()) {
+            if (!minorIndexItem || m_item->getMetadata().getVersion().getMajor() > minorIndexItem->getMetadata().getVersion().getMajor()) {
                 // has major update
                 m_latestVersionLabel = CCLabelBMFont::create(
                     ("Available: " + m_item->getMetadata().getVersion().toString()).c_str(),
@@ -462,7 +462,7 @@ bool LocalModInfoPopup::init(Mod* mod, ModListLayer* list) {
                 m_mainLayer->addChild(m_latestVersionLabel);
             }
 
-            if (minorIndexItem->getMetadata().getVersion() > mod->getMetadata().getVersion()) {
+            if (minorIndexItem && minorIndexItem->getMetadata().getVersion() > mod->getMetadata().getVersion()) {
                 // has minor update
                 m_minorVersionLabel = CCLabelBMFont::create(
                     ("Available: " + minorIndexItem->getMetadata().getVersion().toString()).c_str(),
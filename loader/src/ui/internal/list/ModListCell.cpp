@@ -266,9 +266,8 @@ void ModCell::updateState() {
         m_enableToggle->m_onButton->setColor(!toggleable ? cc3x(155) : cc3x(255));
     }
     bool hasProblems = false;
-    for (auto const& item : Loader::get()->getProblems()) {
+    for (auto const& item : Loader::get()->getProblems(m_mod)) {
         if (!std::holds_alternative<Mod*>(item.cause) ||
-            std::get<Mod*>(item.cause) != m_mod ||
             item.type <= LoadProblem::Type::Recommendation)
             continue;
         hasProblems = true;
@@ -316,17 +315,9 @@ bool ModCell::init(
         auto viewSpr = ButtonSprite::create("View", "bigFont.fnt", "GJ_button_01.png", .8f);
         viewSpr->setScale(.65f);
 
-        auto latestIndexItem = Index::get()->getMajorItem(
-            mod->getMetadata().getID()
-        );
-
-        if (latestIndexItem && Index::get()->isUpdateAvailable(latestIndexItem)) {
+        auto updateStatus = Index::get()->getUpdateStatus(mod->getMetadata().getID());
+        if (updateStatus && updateStatus->updateAvailable) {
             viewSpr->updateBGImage("GE_button_01.png"_spr);
-
-            auto minorIndexItem = Index::get()->getItem(
-                mod->getMetadata().getID(),
-                ComparableVersionInfo(mod->getMetadata().getVersion(), VersionCompare::MoreEq)
-            );
         }
 
         auto viewBtn = CCMenuItemSpriteExtra::create(viewSpr, this, menu_selector(ModCell::onInfo));
@@ -558,13 +549,12 @@ bool ProblemsCell::init(
         return false;
 
     LoadProblem::Type problemType = LoadProblem::Type::Unknown;
-    // iterate problems to find the most important severity
-    for (auto const& problem : Loader::get()->getProblems()) {
-        if (problemType < problem.type)
-            problemType = problem.type;
-        // already found the most important one (error)
-        if (problemType > LoadProblem::Type::Conflict)
+    // find the most important severity
+    for (auto type = static_cast<int>(LoadProblem::Type::UnzipFailed); type > 0; type--) {
+        if (Loader::get()->getProblemCount(static_cast<LoadProblem::Type>(type))) {
+            problemType = static_cast<LoadProblem::Type>(type);
             break;
+        }
     }
 
     std::string icon;
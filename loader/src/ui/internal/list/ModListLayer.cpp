@@ -150,7 +150,7 @@ CCArray* ModListLayer::createModCells(ModListType type, ModListQuery const& quer
         default:
         case ModListType::Installed: {
             // problems first
-            if (!Loader::get()->getProblems().empty()) {
+            if (Loader::get()->getProblemCount()) {
                 mods->addObject(ProblemsCell::create(this, m_display, this->getCellSize()));
             }
 
@@ -1,5 +1,6 @@
 #include <Geode/ui/ScrollLayer.hpp>
 #include <Geode/utils/cocos.hpp>
+#include <algorithm>
 
 using namespace geode::prelude;
 
@@ -18,10 +19,84 @@ void GenericContentLayer::setPosition(CCPoint const& pos) {
     // all be TableViewCells
     CCLayerColor::setPosition(pos);
 
+    if (m_childOrderDirty) {
+        this->rebuildChildOrder();
+    }
+    else {
+        this->updateVisibleChildren();
+    }
+}
+
+void GenericContentLayer::addChild(CCNode* child, int zOrder, int tag) {
+    CCLayerColor::addChild(child, zOrder, tag);
+    m_childOrderDirty = true;
+}
+
+void GenericContentLayer::removeChild(CCNode* child, bool cleanup) {
+    CCLayerColor::removeChild(child, cleanup);
+    m_childOrderDirty = true;
+}
+
+void GenericContentLayer::removeAllChildrenWithCleanup(bool cleanup) {
+    CCLayerColor::removeAllChildrenWithCleanup(cleanup);
+    m_childOrderDirty = true;
+}
+
+void GenericContentLayer::invalidateChildOrder() {
+    m_childOrderDirty = true;
+}
+
+void GenericContentLayer::rebuildChildOrder() {
+    m_culledChildren.clear();
+    m_maxChildHeight = 0.f;
     for (auto child : CCArrayExt<CCNode*>(m_pChildren)) {
-        auto y = this->getPositionY() + child->getPositionY();
-        child->setVisible(!((m_obContentSize.height < y) || (y < -child->getContentSize().height)));
+        auto height = child->getContentSize().height;
+        m_culledChildren.push_back({ child, child->getPositionY(), height });
+        m_maxChildHeight = std::max(m_maxChildHeight, height);
     }
+    std::stable_sort(m_culledChildren.begin(), m_culledChildren.end(), [](auto const& a, auto const& b) {
+        return a.y < b.y;
+    });
+    m_childOrderDirty = false;
+
+    // the visible range isn't known yet, so everything
+    // has to be updated once
+    m_visibleBegin = 0;
+    m_visibleEnd = m_culledChildren.size();
+    this->updateVisibleChildren();
+}
+
+void GenericContentLayer::updateVisibleChildren() {
+    auto const posY = this->getPositionY();
+
+    // a child is visible if -height <= posY + y <= m_obContentSize.height,
+    // so only children with y in this range can possibly be visible
+    auto const minY = -posY - m_maxChildHeight;
+    auto const maxY = m_obContentSize.height - posY;
+
+    auto const begin = static_cast<size_t>(std::lower_bound(
+        m_culledChildren.begin(), m_culledChildren.end(), minY,
+        [](auto const& child, float y) { return child.y < y; }
+    ) - m_culledChildren.begin());
+    auto const end = static_cast<size_t>(std::upper_bound(
+        m_culledChildren.begin() + begin, m_culledChildren.end(), maxY,
+        [](float y, auto const& child) { return y < child.y; }
+    ) - m_culledChildren.begin());
+
+    // hide the children that left the range
+    for (auto i = m_visibleBegin; i < m_visibleEnd; i += 1) {
+        if (i < begin || i >= end) {
+            m_culledChildren[i].node->setVisible(false);
+        }
+    }
+    for (auto i = begin; i < end; i += 1) {
+        auto const& child = m_culledChildren[i];
+        auto y = posY + child.y;
+        child.node->setVisible(!((m_obContentSize.height < y) || (y < -child.height)));
+    }
+
+    m_visibleBegin = begin;
+    m_visibleEnd = end;
 }
 
 void ScrollLayer::visit() {
@@ -1,5 +1,6 @@
 #include <Geode/ui/Scrollbar.hpp>
 #include <Geode/utils/cocos.hpp>
+#include <climits>
 
 using namespace geode::prelude;
 
@@ -12,16 +13,19 @@ bool Scrollbar::ccTouchBegan(CCTouch* touch, CCEvent* event) {
     this->ccTouchMoved(touch, event);
 
     m_touchDown = true;
+    this->updateThumbColor();
 
     return true;
 }
 
 void Scrollbar::ccTouchEnded(CCTouch*, CCEvent*) {
     m_touchDown = false;
+    this->updateThumbColor();
 }
 
 void Scrollbar::ccTouchCancelled(CCTouch*, CCEvent*) {
     m_touchDown = false;
+    this->updateThumbColor();
 }
 
 void Scrollbar::ccTouchMoved(CCTouch* touch, CCEvent*) {
@@ -55,14 +59,38 @@ void Scrollbar::registerWithTouchDispatcher() {
     CCDirector::sharedDirector()->getTouchDispatcher()->addTargetedDelegate(this, 0, true);
 }
 
-void Scrollbar::draw() {
-    CCLayer::draw();
-
+void Scrollbar::update(float) {
     if (!m_target) return;
 
     auto contentHeight = m_target->m_contentLayer->getScaledContentSize().height;
     auto targetHeight = m_target->getScaledContentSize().height;
+    auto scrollPos = m_target->m_contentLayer->getPositionY();
+
+    if (
+        !m_geometryDirty &&
+        contentHeight == m_lastContentHeight &&
+        targetHeight == m_lastTargetHeight &&
+        scrollPos == m_lastScrollPos &&
+        m_target->m_scrollLimitTop == m_lastScrollLimitTop
+    ) {
+        return;
+    }
+
+    // resizing the track re-lays out all of its nine slices, so only do it
+    // when the target actually changed size
+    if (m_geometryDirty || targetHeight != m_lastTargetHeight) {
+        this->updateTrack(targetHeight);
+    }
+    this->updateThumb(targetHeight, contentHeight);
+
+    m_lastContentHeight = contentHeight;
+    m_lastTargetHeight = targetHeight;
+    m_lastScrollPos = scrollPos;
+    m_lastScrollLimitTop = m_target->m_scrollLimitTop;
+    m_geometryDirty = false;
+}
 
+void Scrollbar::updateTrack(float targetHeight) {
     if (m_trackIsRotated) {
         m_track->setContentSize({ targetHeight / m_track->getScale(),
                                   m_width / m_track->getScale() });
@@ -71,31 +99,15 @@ void Scrollbar::draw() {
         m_track->setContentSize({ m_width / m_track->getScale(),
                                   targetHeight / m_track->getScale() });
     }
-    m_track->setPosition(m_obContentSize / 2);
 
     this->setContentSize({ m_width, targetHeight });
+    m_track->setPosition(m_obContentSize / 2);
+}
 
+void Scrollbar::updateThumb(float targetHeight, float contentHeight) {
     auto h = contentHeight - targetHeight + m_target->m_scrollLimitTop;
     auto p = targetHeight / contentHeight;
 
-    GLubyte o;
-    if (m_hoverHighlight) {
-        o = 100;
-        // if (m_extMouseHovered) {
-        // o = 160;
-        // }
-        if (m_touchDown) {
-            o = 255;
-        }
-    }
-    else {
-        o = 255;
-        if (m_touchDown) {
-            o = 125;
-        }
-    }
-    m_thumb->setColor({ o, o, o });
-
     auto y = m_target->m_contentLayer->getPositionY();
 
     auto thumbHeight = m_resizeThumb ? std::min(p, 1.f) * targetHeight / .4f : 0;
@@ -135,8 +147,29 @@ void Scrollbar::draw() {
     }
 }
 
+void Scrollbar::updateThumbColor() {
+    GLubyte o;
+    if (m_hoverHighlight) {
+        o = 100;
+        // if (m_extMouseHovered) {
+        // o = 160;
+        // }
+        if (m_touchDown) {
+            o = 255;
+        }
+    }
+    else {
+        o = 255;
+        if (m_touchDown) {
+            o = 125;
+        }
+    }
+    m_thumb->setColor({ o, o, o });
+}
+
 void Scrollbar::setTarget(CCScrollLayerExt* target) {
     m_target = target;
+    m_geometryDirty = true;
 }
 
 bool Scrollbar::init(CCScrollLayerExt* target) {
@@ -177,6 +210,12 @@ bool Scrollbar::init(CCScrollLayerExt* target) {
     this->addChild(m_track);
     this->addChild(m_thumb);
 
+    this->updateThumbColor();
+    this->update(0.f);
+    // run after everything else that can scroll the target this frame
+    // (like the action manager), so the thumb never trails the content
+    this->scheduleUpdateWithPriority(INT_MAX);
+
     this->setTouchEnabled(true);
 
     return true;
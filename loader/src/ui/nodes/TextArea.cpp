@@ -1,4 +1,5 @@
 #include <Geode/ui/TextArea.hpp>
+#include "TextAreaLayout.hpp"
 
 using namespace geode::prelude;
 
@@ -46,6 +47,16 @@ SimpleTextArea::SimpleTextArea(const std::string& font, const std::string& text,
 }
 
 void SimpleTextArea::setFont(const std::string& font) {
+    if (font != m_font) {
+        // pooled labels are tied to the old font
+        for (CCLabelBMFont* label : m_labelPool) {
+            label->removeFromParent();
+        }
+
+        m_labelPool.clear();
+        m_lines.clear();
+    }
+
     m_font = font;
     m_shouldUpdate = true;
 }
@@ -141,9 +152,60 @@ float SimpleTextArea::getLineHeight() {
     return m_lineHeight;
 }
 
-CCLabelBMFont* SimpleTextArea::createLabel(const std::string& text, const float top) {
-    CCLabelBMFont* label = CCLabelBMFont::create(text.c_str(), m_font.c_str());
+namespace {
+    // Glyph lookups into a loaded .fnt for text_area::LineMeasure
+    class FontConfig {
+        CCBMFontConfiguration* m_config;
+
+    public:
+        FontConfig(CCBMFontConfiguration* config) : m_config(config) {}
+
+        std::optional<text_area::Glyph> glyph(const unsigned short c) const {
+            if (!m_config || !m_config->getCharacterSet()->contains(c)) {
+                return std::nullopt;
+            }
+
+            unsigned int key = c;
+            tCCFontDefHashElement* element = nullptr;
+            HASH_FIND_INT(m_config->m_pFontDefDictionary, &key, element);
+            if (!element) {
+                return std::nullopt;
+            }
+
+            return text_area::Glyph { element->fontDef.xAdvance, element->fontDef.rect.size.width };
+        }
+
+        int kerning(const unsigned short first, const unsigned short second) const {
+            if (!m_config || !m_config->m_pKerningDictionary) {
+                return 0;
+            }
+
+            unsigned int pair = (static_cast<unsigned int>(first) << 16) | second;
+            tCCKerningHashElement* kern = nullptr;
+            HASH_FIND_INT(m_config->m_pKerningDictionary, &pair, kern);
+
+            return kern ? kern->amount : 0;
+        }
+    };
+}
+
+CCLabelBMFont* SimpleTextArea::reuseLabel(const size_t index, const std::string& text, const float top) {
+    CCLabelBMFont* label;
+
+    if (index < m_labelPool.size()) {
+        label = m_labelPool[index];
+
+        if (text != label->getString()) {
+            label->setString(text.c_str());
+        }
+    } else {
+        label = CCLabelBMFont::create(text.c_str(), m_font.c_str());
+
+        m_labelPool.push_back(label);
+        m_container->addChild(label);
+    }
 
+    label->setVisible(true);
     label->setScale(m_scale);
     label->setPosition({ 0, top });
     label->setColor({ m_color.r, m_color.g, m_color.b });
@@ -152,91 +214,77 @@ CCLabelBMFont* SimpleTextArea::createLabel(const std::string& text, const float
     return label;
 }
 
-float SimpleTextArea::calculateOffset(CCLabelBMFont* label) {
-    return m_linePadding + label->getContentSize().height * m_scale;
-}
+float SimpleTextArea::calculateOffset(const std::string& line) {
+    // empty labels have no size
+    if (line.empty()) {
+        return m_linePadding;
+    }
 
-void SimpleTextArea::charIteration(const std::function<CCLabelBMFont*(CCLabelBMFont* line, const char c, const float top)>& overflowHandling) {
-    float top = 0;
-    CCLabelBMFont* line = this->createLabel("", top);
-    m_lines = { line };
+    CCBMFontConfiguration* config = FNTConfigLoadFile(m_font.c_str());
+    const float height = config ? config->m_nCommonHeight / CC_CONTENT_SCALE_FACTOR() : 0;
 
-    for (const char c : m_text) {
-        if (m_maxLines && m_lines.size() > m_maxLines) {
-            CCLabelBMFont* last = m_lines.at(m_maxLines - 1);
-            const std::string text = last->getString();
+    return m_linePadding + height * m_scale;
+}
 
-            m_lines.pop_back();
-            last->setString(text.substr(0, text.size() - 3).append("...").c_str());
+void SimpleTextArea::updateLabels(const std::vector<std::string>& lines, const std::vector<float>& tops) {
+    m_lines.clear();
 
-            break;
-        } else if (c == '\n') {
-            m_lines.push_back(line = this->createLabel("", top -= this->calculateOffset(line)));
-        } else if (m_artificialWidth && line->getContentSize().width * m_scale >= this->getWidth()) {
-            m_lines.push_back(line = overflowHandling(line, c, top -= this->calculateOffset(line)));
-        } else {
-            line->setString((std::string(line->getString()) + c).c_str());
-        }
+    for (size_t i = 0; i < lines.size(); i++) {
+        m_lines.push_back(this->reuseLabel(i, lines[i], tops[i]));
+    }
+    for (size_t i = lines.size(); i < m_labelPool.size(); i++) {
+        m_labelPool[i]->setVisible(false);
     }
 }
 
+void SimpleTextArea::charIteration(const std::function<std::string(std::string& line, const char c)>& overflowHandling) {
+    const FontConfig font(FNTConfigLoadFile(m_font.c_str()));
+    text_area::WrapOptions options;
+    options.maxLines = m_maxLines;
+    options.artificialWidth = m_artificialWidth;
+    options.width = this->getWidth();
+    options.scale = m_scale;
+
+    auto wrapped = text_area::wrapLines(
+        m_text, text_area::LineMeasure(font, CC_CONTENT_SCALE_FACTOR()), options,
+        [this](const std::string& line) { return this->calculateOffset(line); },
+        overflowHandling
+    );
+
+    this->updateLabels(wrapped.lines, wrapped.tops);
+}
+
 void SimpleTextArea::updateLinesNoWrap() {
     std::stringstream stream(m_text);
     std::string part;
     float top = 0;
+    std::vector<std::string> lines;
+    std::vector<float> tops;
 
     while (std::getline(stream, part)) {
-        if (m_maxLines && m_lines.size() >= m_maxLines) {
-            CCLabelBMFont* last = m_lines.at(m_maxLines - 1);
-            const std::string text = last->getString();
+        if (m_maxLines && lines.size() >= m_maxLines) {
+            std::string& last = lines.at(m_maxLines - 1);
 
-            last->setString(text.substr(0, text.size() - 3).append("...").c_str());
+            last = last.substr(0, last.size() - 3).append("...");
 
             break;
         } else {
-            CCLabelBMFont* line = this->createLabel(part, 0);
+            tops.push_back(top);
+            top -= this->calculateOffset(part);
 
-            top -= this->calculateOffset(line);
-
-            m_lines.push_back(line);
+            lines.push_back(part);
         }
     }
+
+    this->updateLabels(lines, tops);
 }
 
 void SimpleTextArea::updateLinesWordWrap() {
-    this->charIteration([this](CCLabelBMFont* line, const char c, const float top) {
-        static std::string delimiters(" `~!@#$%^&*()-_=+[{}];:'\",<.>/?\\|");
-
-        if (delimiters.find(c) == std::string_view::npos) {
-            const std::string text = line->getString();
-            const size_t position = text.find_last_of(delimiters) + 1;
-
-            line->setString(text.substr(0, position).c_str());
-
-            return this->createLabel(text.substr(position) + c, top);
-        } else {
-            return this->createLabel(std::string(c, c != ' '), top);
-        }
-    });
+    this->charIteration(&text_area::wordWrapOverflow);
 }
 
 void SimpleTextArea::updateLinesCutoffWrap() {
-    this->charIteration([this](CCLabelBMFont* line, const char c, const float top) {
-        const std::string text = line->getString();
-        const char back = text.back();
-        const bool lastIsSpace = back == ' ';
-        CCLabelBMFont* newLine = this->createLabel(std::string(!lastIsSpace, back).append(std::string(c != ' ', c)), top);
-
-        if (!lastIsSpace) {
-            if (text[text.size() - 2] == ' ') {
-                line->setString(text.substr(0, text.size() - 1).c_str());
-            } else {
-                line->setString((text.substr(0, text.size() - 1) + '-').c_str());
-            }
-        }
-
-        return newLine;
-    });
+    this->charIteration(&text_area::cutoffWrapOverflow);
 }
 
 void SimpleTextArea::updateContainer() {
@@ -265,7 +313,6 @@ void SimpleTextArea::updateContainer() {
 
     this->setContentSize({ width, height });
     m_container->setContentSize(this->getContentSize());
-    m_container->removeAllChildren();
 
     for (CCLabelBMFont* line : m_lines) {
         const float y = height + line->getPositionY();
@@ -284,8 +331,6 @@ void SimpleTextArea::updateContainer() {
                 line->setPosition({ width, y });
             } break;
         }
-
-        m_container->addChild(line);
     }
 }
 
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Line breaking for SimpleTextArea. This only depends on the standard library
+// so it can be unit tested against a font file on its own (see loader/test/unit)
+namespace geode::text_area {
+    struct Glyph {
+        int xAdvance;
+        float width;
+    };
+
+    // Measures a line the same way CCLabelBMFont::createFontChars sizes its
+    // content, but one character at a time so lines never have to be
+    // rendered just to find where they wrap. Font needs to provide
+    // `std::optional<Glyph> glyph(unsigned short c)` and
+    // `int kerning(unsigned short first, unsigned short second)`
+    template <class Font>
+    class LineMeasure {
+        Font const& m_font;
+        float m_scaleFactor;
+        int m_position = 0;
+        int m_longest = 0;
+        unsigned short m_prev = -1;
+        std::optional<Glyph> m_last;
+
+    public:
+        LineMeasure(Font const& font, const float scaleFactor) : m_font(font), m_scaleFactor(scaleFactor) {}
+
+        void reset() {
+            m_position = 0;
+            m_longest = 0;
+            m_prev = -1;
+            m_last = std::nullopt;
+        }
+
+        void push(const char c) {
+            const unsigned short ch = static_cast<unsigned char>(c);
+            auto glyph = m_font.glyph(ch);
+            if (!glyph) {
+                return;
+            }
+
+            m_last = glyph;
+            m_position += glyph->xAdvance + m_font.kerning(m_prev, ch);
+            m_prev = ch;
+            m_longest = std::max(m_longest, m_position);
+        }
+
+        void assign(const std::string& text) {
+            this->reset();
+            for (const char c : text) {
+                this->push(c);
+            }
+        }
+
+        float width() const {
+            if (!m_last) {
+                return 0;
+            }
+            float width = m_longest;
+            if (m_last->xAdvance < m_last->width) {
+                width = m_longest + m_last->width - m_last->xAdvance;
+            }
+            return width / m_scaleFactor;
+        }
+    };
+
+    struct WrapOptions {
+        size_t maxLines = 0;
+        // lines only wrap once the width has been set explicitly
+        bool artificialWidth = false;
+        float width = 0;
+        float scale = 1;
+    };
+
+    struct WrappedLines {
+        std::vector<std::string> lines;
+        std::vector<float> tops;
+    };
+
+    // Breaks the text into lines, calling overflowHandling with the current
+    // line and the next character once the line gets too wide. It returns
+    // the start of the next line, and may shorten the current one
+    template <class Font, class Offset, class Overflow>
+    WrappedLines wrapLines(
+        const std::string& text, LineMeasure<Font> measure, const WrapOptions& options,
+        Offset&& calculateOffset, Overflow&& overflowHandling
+    ) {
+        float top = 0;
+        WrappedLines result = { { "" }, { top } };
+        auto& lines = result.lines;
+        auto& tops = result.tops;
+
+        measure.reset();
+        for (const char c : text) {
+            if (options.maxLines && lines.size() > options.maxLines) {
+                lines.pop_back();
+                tops.pop_back();
+
+                std::string& last = lines.at(options.maxLines - 1);
+
+                last = last.substr(0, last.size() - 3).append("...");
+
+                break;
+            } else if (c == '\n') {
+                tops.push_back(top -= calculateOffset(lines.back()));
+                lines.emplace_back();
+                measure.reset();
+            } else if (options.artificialWidth && measure.width() * options.scale >= options.width) {
+                tops.push_back(top -= calculateOffset(lines.back()));
+
+                std::string next = overflowHandling(lines.back(), c);
+
+                lines.push_back(std::move(next));
+                measure.assign(lines.back());
+            } else {
+                lines.back() += c;
+                measure.push(c);
+            }
+        }
+
+        return result;
+    }
+
+    // Moves the word being cut off to the next line
+    inline std::string wordWrapOverflow(std::string& line, const char c) {
+        static std::string delimiters(" `~!@#$%^&*()-_=+[{}];:'\",<.>/?\\|");
+
+        if (delimiters.find(c) == std::string_view::npos) {
+            const size_t position = line.find_last_of(delimiters) + 1;
+            std::string next = line.substr(position) + c;
+
+            line.erase(position);
+
+            return next;
+        } else {
+            return std::string(c != ' ', c);
+        }
+    }
+
+    // Cuts the word off with a hyphen
+    inline std::string cutoffWrapOverflow(std::string& line, const char c) {
+        const char back = line.back();
+        const bool lastIsSpace = back == ' ';
+        std::string next = std::string(!lastIsSpace, back).append(std::string(c != ' ', c));
+
+        if (!lastIsSpace) {
+            if (line.size() > 1 && line[line.size() - 2] == ' ') {
+                line.pop_back();
+            } else {
+                line.back() = '-';
+            }
+        }
+
+        return next;
+    }
+}
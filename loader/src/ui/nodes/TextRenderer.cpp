@@ -377,7 +377,7 @@ std::vector<TextRenderer::Label> TextRenderer::renderStringEx(
     if (!createLabel()) return {};
 
     bool firstLine = true;
-    for (auto line : utils::string::split(str, "\n")) {
+    for (auto line : utils::string::splitView(str, "\n")) {
         if (!firstLine && !nextLine()) {
             return {};
         }
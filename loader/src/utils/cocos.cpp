@@ -1,6 +1,8 @@
 #include <Geode/modify/LoadingLayer.hpp>
 #include <Geode/utils/cocos.hpp>
+#include <loader/LoaderImpl.hpp>
 #include <matjson.hpp>
+#include <algorithm>
 #include <charconv>
 
 using namespace geode::prelude;
@@ -392,30 +394,85 @@ void geode::cocos::reloadTextures(CreateLayerFunc returnTo) {
     GameManager::get()->reloadAll(false, false, true);
 }
 
-void GEODE_DLL geode::cocos::handleTouchPriorityWith(cocos2d::CCNode* node, int priority, bool force) {
+size_t geode::cocos::reloadChangedTextures(utils::MiniFunction<void()> const& changeSearchPaths) {
+    return LoaderImpl::get()->reloadChangedTextures(changeSearchPaths);
+}
+
+TouchPriorityBatch::TouchPriorityBatch() {
+    auto dispatcher = CCTouchDispatcher::get();
+    // findHandler checks targeted handlers first, so those win
+    for (auto handlers : { dispatcher->m_pTargetedHandlers, dispatcher->m_pStandardHandlers }) {
+        for (auto handler : CCArrayExt<CCTouchHandler*>(handlers)) {
+            m_handlers.emplace(handler->m_pDelegate, handler);
+        }
+    }
+}
+
+TouchPriorityBatch::~TouchPriorityBatch() {
+    this->apply();
+}
+
+CCTouchHandler* TouchPriorityBatch::findHandler(CCNode* node) const {
+    if (m_handlers.empty()) {
+        return nullptr;
+    }
+    if (auto delegate = typeinfo_cast<CCTouchDelegate*>(node)) {
+        auto it = m_handlers.find(delegate);
+        if (it != m_handlers.end()) {
+            return it->second;
+        }
+    }
+    return nullptr;
+}
+
+void TouchPriorityBatch::assign(CCNode* node, int priority, bool force) {
     for (auto child : CCArrayExt<CCNode*>(node->getChildren())) {
-        if (auto delegate = typeinfo_cast<CCTouchDelegate*>(child)) {
-            if (auto handler = CCTouchDispatcher::get()->findHandler(delegate)) {
-                if (!force && handler->m_nPriority < priority) {
-                    handleTouchPriorityWith(child, handler->m_nPriority - 1, force);
-                    continue;
-                }
-                else {
-                    CCTouchDispatcher::get()->setPriority(priority, delegate);
-                }
+        if (auto handler = this->findHandler(child)) {
+            if (!force && handler->m_nPriority < priority) {
+                this->assign(child, handler->m_nPriority - 1, force);
+                continue;
+            }
+            else if (handler->m_nPriority != priority) {
+                handler->m_nPriority = priority;
+                m_changed = true;
             }
         }
-        handleTouchPriorityWith(child, priority, force);
+        this->assign(child, priority, force);
     }
 }
+
+void TouchPriorityBatch::apply() {
+    if (!m_changed) {
+        return;
+    }
+    m_changed = false;
+
+    auto dispatcher = CCTouchDispatcher::get();
+    for (auto handlers : { dispatcher->m_pTargetedHandlers, dispatcher->m_pStandardHandlers }) {
+        if (!handlers || !handlers->data->num) {
+            continue;
+        }
+        // same ordering as CCTouchDispatcher::rearrangeHandlers, but stable
+        std::stable_sort(
+            handlers->data->arr, handlers->data->arr + handlers->data->num,
+            [](CCObject* a, CCObject* b) {
+                return static_cast<CCTouchHandler*>(a)->m_nPriority < 
+                    static_cast<CCTouchHandler*>(b)->m_nPriority;
+            }
+        );
+    }
+}
+
+void GEODE_DLL geode::cocos::handleTouchPriorityWith(cocos2d::CCNode* node, int priority, bool force) {
+    TouchPriorityBatch().assign(node, priority, force);
+}
 void GEODE_DLL geode::cocos::handleTouchPriority(cocos2d::CCNode* node, bool force) {
     Loader::get()->queueInMainThread([node, force]() {
-        if (auto delegate = typeinfo_cast<CCTouchDelegate*>(node)) {
-            if (auto handler = CCTouchDispatcher::get()->findHandler(delegate)) {
-                return handleTouchPriorityWith(node, handler->m_nPriority - 1, force);
-            }
+        TouchPriorityBatch batch;
+        if (auto handler = batch.findHandler(node)) {
+            return batch.assign(node, handler->m_nPriority - 1, force);
         }
-        handleTouchPriorityWith(node, 0, force);
+        batch.assign(node, 0, force);
     });
 }
 
@@ -4,7 +4,12 @@
 #include <Geode/utils/map.hpp>
 #include <Geode/utils/string.hpp>
 #include <matjson.hpp>
+#include <atomic>
 #include <fstream>
+#include <optional>
+#include <span>
+#include <thread>
+#include <zlib.h>
 #include <mz.h>
 #include <mz_os.h>
 #include <mz_strm.h>
@@ -15,30 +20,100 @@
 
 #ifdef GEODE_IS_WINDOWS
 #include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 using namespace geode::prelude;
 using namespace geode::utils::file;
 
-Result<std::string> utils::file::readString(ghc::filesystem::path const& path) {
-    if (!ghc::filesystem::exists(path))
-        return Err("File does not exist");
-
-#if _WIN32
-    std::ifstream in(path.wstring(), std::ios::in | std::ios::binary);
+// Reads a whole file into a string or byte vector, sized up front from the 
+// file's size so regular files take a single read
+template <class T>
+static Result<T> readWholeFile(ghc::filesystem::path const& path) {
+    T contents;
+#ifdef GEODE_IS_WINDOWS
+    auto handle = CreateFileW(
+        path.wstring().c_str(), GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+    if (handle == INVALID_HANDLE_VALUE) {
+        auto err = GetLastError();
+        if (err == ERROR_FILE_NOT_FOUND || err == ERROR_PATH_NOT_FOUND) {
+            return Err("File does not exist");
+        }
+        return Err("Unable to open file");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        CloseHandle(handle);
+        return Err("Unable to read file");
+    }
+    contents.resize(static_cast<size_t>(size.QuadPart));
+    size_t offset = 0;
+    while (offset < contents.size()) {
+        DWORD read = 0;
+        auto chunk = static_cast<DWORD>(std::min<size_t>(contents.size() - offset, 1u << 30));
+        if (!ReadFile(handle, contents.data() + offset, chunk, &read, nullptr)) {
+            CloseHandle(handle);
+            return Err("Unable to read file");
+        }
+        if (read == 0) {
+            break;
+        }
+        offset += read;
+    }
+    CloseHandle(handle);
 #else
-    std::ifstream in(path.string(), std::ios::in | std::ios::binary);
-#endif
-    if (!in)
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT || errno == ENOTDIR) {
+            return Err("File does not exist");
+        }
         return Err("Unable to open file");
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return Err("Unable to read file");
+    }
+    // special files may not know their size, so read those until EOF
+    auto const sized = S_ISREG(st.st_mode) && st.st_size > 0;
+    contents.resize(sized ? static_cast<size_t>(st.st_size) : 4096);
+    size_t offset = 0;
+    while (true) {
+        if (offset == contents.size()) {
+            if (sized) {
+                break;
+            }
+            contents.resize(contents.size() * 2);
+        }
+        auto read = ::read(fd, contents.data() + offset, contents.size() - offset);
+        if (read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ::close(fd);
+            return Err("Unable to read file");
+        }
+        if (read == 0) {
+            break;
+        }
+        offset += static_cast<size_t>(read);
+    }
+    ::close(fd);
+#endif
+    // the file may have shrunk since its size was checked
+    contents.resize(offset);
+    return Ok(std::move(contents));
+}
 
-    std::string contents;
-    in.seekg(0, std::ios::end);
-    contents.resize((const size_t)in.tellg());
-    in.seekg(0, std::ios::beg);
-    in.read(&contents[0], contents.size());
-    in.close();
-    return Ok(contents);
+Result<std::string> utils::file::readString(ghc::filesystem::path const& path) {
+    return readWholeFile<std::string>(path);
 }
 
 Result<matjson::Value> utils::file::readJson(ghc::filesystem::path const& path) {
@@ -46,25 +121,122 @@ Result<matjson::Value> utils::file::readJson(ghc::filesystem::path const& path)
     if (!str)
         return Err(str.unwrapErr());
     std::string error;
-    auto res = matjson::parse(str.value(), error);
+    auto res = matjson::parse(str.unwrap(), error);
     if (error.size())
         return Err("Unable to parse JSON: " + error);
-    return Ok(res.value());
+    return Ok(std::move(res.value()));
 }
 
 Result<ByteVector> utils::file::readBinary(ghc::filesystem::path const& path) {
-    if (!ghc::filesystem::exists(path))
-        return Err("File does not exist");
+    return readWholeFile<ByteVector>(path);
+}
 
-#if _WIN32
-    std::ifstream in(path.wstring(), std::ios::in | std::ios::binary);
+class MappedFile::Impl final {
+public:
+    uint8_t const* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef GEODE_IS_WINDOWS
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+
+    ~Impl() {
+#ifdef GEODE_IS_WINDOWS
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+        }
 #else
-    std::ifstream in(path.string(), std::ios::in | std::ios::binary);
+        if (m_data) {
+            ::munmap(const_cast<uint8_t*>(m_data), m_size);
+        }
 #endif
-    if (!in)
+    }
+};
+
+MappedFile::MappedFile(std::unique_ptr<Impl>&& impl) : m_impl(std::move(impl)) {}
+
+MappedFile::MappedFile(MappedFile&& other) : m_impl(std::move(other.m_impl)) {
+    other.m_impl = nullptr;
+}
+
+MappedFile::~MappedFile() {}
+
+Result<MappedFile> MappedFile::create(ghc::filesystem::path const& path) {
+    auto impl = std::make_unique<Impl>();
+#ifdef GEODE_IS_WINDOWS
+    impl->m_file = CreateFileW(
+        path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (impl->m_file == INVALID_HANDLE_VALUE) {
+        auto err = GetLastError();
+        if (err == ERROR_FILE_NOT_FOUND || err == ERROR_PATH_NOT_FOUND) {
+            return Err("File does not exist");
+        }
         return Err("Unable to open file");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(impl->m_file, &size)) {
+        return Err("Unable to read file");
+    }
+    // empty files can't be mapped, but there's nothing to map anyway
+    if (size.QuadPart == 0) {
+        return Ok(MappedFile(std::move(impl)));
+    }
+    impl->m_mapping = CreateFileMappingW(impl->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!impl->m_mapping) {
+        return Err("Unable to map file");
+    }
+    impl->m_data = static_cast<uint8_t const*>(MapViewOfFile(impl->m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!impl->m_data) {
+        return Err("Unable to map file");
+    }
+    impl->m_size = static_cast<size_t>(size.QuadPart);
+#else
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT || errno == ENOTDIR) {
+            return Err("File does not exist");
+        }
+        return Err("Unable to open file");
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return Err("Unable to map file");
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return Ok(MappedFile(std::move(impl)));
+    }
+    auto data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps the file alive on its own
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return Err("Unable to map file");
+    }
+    impl->m_data = static_cast<uint8_t const*>(data);
+    impl->m_size = static_cast<size_t>(st.st_size);
+#endif
+    return Ok(MappedFile(std::move(impl)));
+}
+
+uint8_t const* MappedFile::data() const {
+    return m_impl->m_data;
+}
+
+size_t MappedFile::size() const {
+    return m_impl->m_size;
+}
 
-    return Ok(ByteVector(std::istreambuf_iterator<char>(in), {}));
+std::string_view MappedFile::view() const {
+    return std::string_view(reinterpret_cast<char const*>(m_impl->m_data), m_impl->m_size);
 }
 
 Result<> utils::file::writeString(ghc::filesystem::path const& path, std::string const& data) {
@@ -130,23 +302,41 @@ Result<> utils::file::createDirectoryAll(ghc::filesystem::path const& path) {
 Result<std::vector<ghc::filesystem::path>> utils::file::readDirectory(
     ghc::filesystem::path const& path, bool recursive
 ) {
-    if (!ghc::filesystem::exists(path)) {
+    std::vector<ghc::filesystem::path> res;
+    GEODE_UNWRAP(iterateDirectory(path, [&](ghc::filesystem::directory_entry const& entry) {
+        res.push_back(entry.path());
+    }, recursive));
+    return Ok(res);
+}
+
+Result<> utils::file::iterateDirectory(
+    ghc::filesystem::path const& path,
+    MiniFunction<void(ghc::filesystem::directory_entry const&)> callback,
+    bool recursive
+) {
+    std::error_code ec;
+    auto status = ghc::filesystem::status(path, ec);
+    if (!ghc::filesystem::exists(status)) {
         return Err("Directory does not exist");
     }
-    if (!ghc::filesystem::is_directory(path)) {
+    if (!ghc::filesystem::is_directory(status)) {
         return Err("Path is not a directory");
     }
-    std::vector<ghc::filesystem::path> res;
+    // directory entries carry the file type straight from the directory 
+    // listing, so callers can check it without another stat
     if (recursive) {
-        for (auto const& file : ghc::filesystem::recursive_directory_iterator(path)) {
-            res.push_back(file.path());
+        for (auto const& file : ghc::filesystem::recursive_directory_iterator(path, ec)) {
+            callback(file);
         }
     } else {
-        for (auto const& file : ghc::filesystem::directory_iterator(path)) {
-            res.push_back(file.path());
+        for (auto const& file : ghc::filesystem::directory_iterator(path, ec)) {
+            callback(file);
         }
     }
-    return Ok(res);
+    if (ec) {
+        return Err("Unable to read directory: " + ec.message());
+    }
+    return Ok();
 }
 
 // Unzip
@@ -157,8 +347,159 @@ struct ZipEntry {
     bool isDirectory;
     int64_t compressedSize;
     int64_t uncompressedSize;
+    // only filled in for archives read through the central directory index
+    uint16_t method = 0;
+    uint32_t crc = 0;
+    uint64_t localHeaderOffset = 0;
 };
 
+namespace {
+    // Entries are deflated in blocks so a single large entry can still be 
+    // spread across threads. Every block but the last ends with a sync flush 
+    // so the raw streams can simply be written one after another, and each 
+    // block is primed with the tail of the previous one to keep the ratio
+    constexpr size_t ZIP_BLOCK_SIZE = 1024 * 1024;
+    constexpr size_t ZIP_DICT_SIZE = 32 * 1024;
+    // How much file data Zip::addAllFrom reads before compressing it
+    constexpr size_t ZIP_BATCH_SIZE = 64 * 1024 * 1024;
+
+    struct DeflatedEntry {
+        std::vector<ByteVector> blocks;
+        size_t compressedSize = 0;
+        uint32_t crc = 0;
+        bool stored = true;
+    };
+
+    size_t resolveThreadCount(size_t count) {
+        if (count == 0) {
+            return std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        return count;
+    }
+
+    template <class F>
+    void runParallel(size_t count, size_t threads, F&& task) {
+        threads = std::min(threads, count);
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; i++) {
+                task(i);
+            }
+            return;
+        }
+        std::atomic_size_t next = 0;
+        auto work = [&]() {
+            for (auto i = next++; i < count; i = next++) {
+                task(i);
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (size_t i = 1; i < threads; i++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    Result<ByteVector> deflateBlock(
+        uint8_t const* data, size_t size, size_t dictSize, bool last, int level
+    ) {
+        z_stream stream {};
+        if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return Err("Unable to initialize deflate");
+        }
+        if (dictSize && deflateSetDictionary(&stream, data - dictSize, dictSize) != Z_OK) {
+            deflateEnd(&stream);
+            return Err("Unable to prime deflate dictionary");
+        }
+
+        // the bound covers everything but the few bytes of the sync flush
+        ByteVector out(deflateBound(&stream, size) + 16);
+        stream.next_in = const_cast<Bytef*>(data);
+        stream.avail_in = static_cast<uInt>(size);
+        auto const flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+        while (true) {
+            stream.next_out = out.data() + stream.total_out;
+            stream.avail_out = static_cast<uInt>(out.size() - stream.total_out);
+            auto res = deflate(&stream, flush);
+            if (res == Z_STREAM_ERROR) {
+                deflateEnd(&stream);
+                return Err("Unable to deflate data");
+            }
+            if (last ? res == Z_STREAM_END : stream.avail_out != 0) {
+                break;
+            }
+            out.resize(out.size() * 2);
+        }
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return Ok(std::move(out));
+    }
+
+    Result<std::vector<DeflatedEntry>> deflateEntries(
+        std::vector<ByteVector const*> const& sources, int level, size_t threads
+    ) {
+        struct Block {
+            size_t entry;
+            size_t offset;
+            size_t size;
+            uint32_t crc = 0;
+            ByteVector out;
+            std::string error;
+        };
+        std::vector<Block> blocks;
+        for (size_t i = 0; i < sources.size(); i++) {
+            auto size = sources[i]->size();
+            for (size_t offset = 0; offset < size; offset += ZIP_BLOCK_SIZE) {
+                blocks.push_back({ i, offset, std::min(ZIP_BLOCK_SIZE, size - offset) });
+            }
+        }
+
+        runParallel(blocks.size(), threads, [&](size_t i) {
+            auto& block = blocks[i];
+            auto& src = *sources[block.entry];
+            auto data = src.data() + block.offset;
+            block.crc = crc32(0, data, static_cast<uInt>(block.size));
+            if (level == 0) {
+                return;
+            }
+            auto res = deflateBlock(
+                data, block.size, std::min(block.offset, ZIP_DICT_SIZE),
+                block.offset + block.size == src.size(), level
+            );
+            if (res) {
+                block.out = std::move(res.unwrap());
+            }
+            else {
+                block.error = res.unwrapErr();
+            }
+        });
+
+        std::vector<DeflatedEntry> ret(sources.size());
+        for (auto& block : blocks) {
+            if (!block.error.empty()) {
+                return Err(std::move(block.error));
+            }
+            auto& entry = ret[block.entry];
+            entry.crc = crc32_combine(entry.crc, block.crc, static_cast<z_off_t>(block.size));
+            entry.compressedSize += block.out.size();
+            entry.blocks.push_back(std::move(block.out));
+        }
+        for (size_t i = 0; i < ret.size(); i++) {
+            auto& entry = ret[i];
+            // incompressible data (or level 0) is stored as-is
+            entry.stored = level == 0 || entry.compressedSize >= sources[i]->size();
+            if (entry.stored) {
+                entry.blocks.clear();
+                entry.compressedSize = sources[i]->size();
+            }
+        }
+        return Ok(std::move(ret));
+    }
+}
+
 class Zip::Impl final {
 public:
     using Path = Zip::Path;
@@ -169,8 +510,281 @@ private:
     int32_t m_mode;
     std::variant<Path, ByteVector> m_srcDest;
     std::unordered_map<Path, ZipEntry> m_entries;
+    int m_level = MZ_COMPRESS_LEVEL_DEFAULT;
+    size_t m_threads = 1;
+
+    struct PendingEntry {
+        Path entry;
+        Path file;
+        bool isFolder;
+    };
+    std::vector<PendingEntry> m_pending;
+    size_t m_pendingSize = 0;
+
+    // Archives opened for reading are mapped (or read from memory) and have 
+    // their central directory indexed up front, so entries are read straight 
+    // out of the archive without going through minizip's single cursor. Only 
+    // archives minizip is needed for (encryption, unusual compression 
+    // methods, split archives) fall back to it
+    std::optional<MappedFile> m_mapped;
+    std::span<uint8_t const> m_archive;
+    bool m_indexed = false;
+
+    template <class T>
+    static T readLE(uint8_t const* data) {
+        T ret = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            ret |= static_cast<T>(data[i]) << (i * 8);
+        }
+        return ret;
+    }
+
+    Result<> indexArchive() {
+        if (std::holds_alternative<Path>(m_srcDest)) {
+            GEODE_UNWRAP_INTO(auto mapped, MappedFile::create(std::get<Path>(m_srcDest)));
+            m_mapped.emplace(std::move(mapped));
+            m_archive = std::span(m_mapped->data(), m_mapped->size());
+        }
+        else {
+            auto& src = std::get<ByteVector>(m_srcDest);
+            m_archive = std::span(src.data(), src.size());
+        }
+        auto const data = m_archive.data();
+        auto const size = m_archive.size();
+
+        // find the end of central directory record, which is followed by a 
+        // comment of at most 64k
+        constexpr size_t EOCD_SIZE = 22;
+        if (size < EOCD_SIZE) {
+            return Err("Archive is too small");
+        }
+        std::optional<size_t> eocd;
+        auto const searchEnd = size - EOCD_SIZE;
+        auto const searchStart = searchEnd > 0xffff ? searchEnd - 0xffff : 0;
+        for (auto i = searchEnd + 1; i-- > searchStart; ) {
+            if (readLE<uint32_t>(data + i) == 0x06054b50) {
+                eocd = i;
+                break;
+            }
+        }
+        if (!eocd) {
+            return Err("End of central directory not found");
+        }
+        if (readLE<uint16_t>(data + *eocd + 4) != 0 || readLE<uint16_t>(data + *eocd + 6) != 0) {
+            return Err("Split archives are not supported");
+        }
+        uint64_t entryCount = readLE<uint16_t>(data + *eocd + 10);
+        uint64_t dirSize = readLE<uint32_t>(data + *eocd + 12);
+        uint64_t dirOffset = readLE<uint32_t>(data + *eocd + 16);
+
+        // zip64 archives store the real values in another record
+        if (entryCount == 0xffff || dirSize == 0xffffffff || dirOffset == 0xffffffff) {
+            if (*eocd < 20 || readLE<uint32_t>(data + *eocd - 20) != 0x07064b50) {
+                return Err("Zip64 locator not found");
+            }
+            auto zip64 = readLE<uint64_t>(data + *eocd - 20 + 8);
+            if (size < 56 || zip64 > size - 56 || readLE<uint32_t>(data + zip64) != 0x06064b50) {
+                return Err("Zip64 end of central directory not found");
+            }
+            entryCount = readLE<uint64_t>(data + zip64 + 32);
+            dirSize = readLE<uint64_t>(data + zip64 + 40);
+            dirOffset = readLE<uint64_t>(data + zip64 + 48);
+        }
+        if (dirOffset > size || dirSize > size - dirOffset) {
+            return Err("Central directory is out of bounds");
+        }
+        // every entry takes at least 46 bytes, so a larger count is corrupt 
+        // and must not be trusted for the reserve below
+        if (entryCount > dirSize / 46) {
+            return Err("Central directory entry count is invalid");
+        }
+
+        std::unordered_map<Path, ZipEntry> entries;
+        entries.reserve(entryCount);
+        auto pos = dirOffset;
+        auto const end = dirOffset + dirSize;
+        for (uint64_t i = 0; i < entryCount; i++) {
+            if (end - pos < 46 || readLE<uint32_t>(data + pos) != 0x02014b50) {
+                return Err("Invalid central directory entry");
+            }
+            auto const header = data + pos;
+            auto const flags = readLE<uint16_t>(header + 8);
+            auto const method = readLE<uint16_t>(header + 10);
+            auto const nameLen = readLE<uint16_t>(header + 28);
+            auto const extraLen = readLE<uint16_t>(header + 30);
+            auto const commentLen = readLE<uint16_t>(header + 32);
+            if (end - pos < 46u + nameLen + extraLen + commentLen) {
+                return Err("Invalid central directory entry");
+            }
+            if (flags & 1) {
+                return Err("Encrypted entries are not supported");
+            }
+            if (method != MZ_COMPRESS_METHOD_STORE && method != MZ_COMPRESS_METHOD_DEFLATE) {
+                return Err("Unsupported compression method " + std::to_string(method));
+            }
+
+            ZipEntry entry {
+                .compressedSize = readLE<uint32_t>(header + 20),
+                .uncompressedSize = readLE<uint32_t>(header + 24),
+                .method = method,
+                .crc = readLE<uint32_t>(header + 16),
+                .localHeaderOffset = readLE<uint32_t>(header + 42),
+            };
+
+            // zip64 extra field, holding the values that didn't fit
+            auto extra = header + 46 + nameLen;
+            auto const extraEnd = extra + extraLen;
+            while (extraEnd - extra >= 4) {
+                auto const id = readLE<uint16_t>(extra);
+                auto const len = readLE<uint16_t>(extra + 2);
+                if (extraEnd - extra - 4 < len) {
+                    break;
+                }
+                if (id == 0x0001) {
+                    auto field = extra + 4;
+                    auto const fieldEnd = field + len;
+                    auto next = [&](auto& value) {
+                        if (value == 0xffffffff && fieldEnd - field >= 8) {
+                            value = readLE<uint64_t>(field);
+                            field += 8;
+                        }
+                    };
+                    next(entry.uncompressedSize);
+                    next(entry.compressedSize);
+                    next(entry.localHeaderOffset);
+                }
+                extra += 4 + len;
+            }
+
+            auto name = reinterpret_cast<char const*>(header + 46);
+            entry.isDirectory = nameLen && (name[nameLen - 1] == '/' || name[nameLen - 1] == '\\');
+
+            Path filePath;
+            filePath.assign(name, name + nameLen);
+            entries.insert({ filePath, entry });
+
+            pos += 46u + nameLen + extraLen + commentLen;
+        }
+
+        m_entries = std::move(entries);
+        m_indexed = true;
+        return Ok();
+    }
+
+    // the entry's data as stored in the archive
+    Result<std::span<uint8_t const>> entryData(ZipEntry const& entry) const {
+        auto const data = m_archive.data();
+        auto const size = m_archive.size();
+        auto const offset = entry.localHeaderOffset;
+        if (offset > size || size - offset < 30 || readLE<uint32_t>(data + offset) != 0x04034b50) {
+            return Err("Invalid local header");
+        }
+        auto const start = offset + 30 +
+            readLE<uint16_t>(data + offset + 26) + readLE<uint16_t>(data + offset + 28);
+        auto const compressedSize = static_cast<uint64_t>(entry.compressedSize);
+        if (start > size || size - start < compressedSize) {
+            return Err("Entry data is out of bounds");
+        }
+        return Ok(std::span(data + start, compressedSize));
+    }
+
+    Result<ByteVector> extractIndexed(ZipEntry const& entry) const {
+        GEODE_UNWRAP_INTO(auto data, this->entryData(entry));
+        ByteVector res;
+        // if the file is empty, its data is empty (duh)
+        if (!entry.uncompressedSize) {
+            return Ok(res);
+        }
+        if (entry.method == MZ_COMPRESS_METHOD_STORE) {
+            res.assign(data.begin(), data.end());
+        }
+        else {
+            res.resize(entry.uncompressedSize);
+            z_stream stream {};
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+                return Err("Unable to initialize inflate");
+            }
+            size_t inPos = 0;
+            size_t outPos = 0;
+            int status = Z_OK;
+            while (status == Z_OK) {
+                // zlib counts in uInt, so feed large entries in chunks
+                auto const inChunk = std::min<size_t>(data.size() - inPos, 1u << 30);
+                auto const outChunk = std::min<size_t>(res.size() - outPos, 1u << 30);
+                stream.next_in = const_cast<Bytef*>(data.data() + inPos);
+                stream.avail_in = static_cast<uInt>(inChunk);
+                stream.next_out = res.data() + outPos;
+                stream.avail_out = static_cast<uInt>(outChunk);
+                status = inflate(&stream, Z_NO_FLUSH);
+                inPos += inChunk - stream.avail_in;
+                outPos += outChunk - stream.avail_out;
+                // no progress means the data is truncated or the size is wrong
+                if (status == Z_OK && inChunk == stream.avail_in && outChunk == stream.avail_out) {
+                    status = Z_DATA_ERROR;
+                }
+                if (status == Z_BUF_ERROR) {
+                    status = Z_DATA_ERROR;
+                }
+            }
+            inflateEnd(&stream);
+            if (status != Z_STREAM_END || outPos != res.size()) {
+                return Err("Unable to inflate entry (code " + std::to_string(status) + ")");
+            }
+        }
+        if (crc32_z(0, res.data(), res.size()) != entry.crc) {
+            return Err("Entry checksum mismatch");
+        }
+        return Ok(std::move(res));
+    }
+
+    Result<> extractAllToIndexed(Path const& dir, file::UnzipProgress const& progress) {
+        size_t done = 0;
+        for (auto const& [filePath, entry] : m_entries) {
+            if (progress && !progress(done++, m_entries.size())) {
+                return Err("Cancelled");
+            }
+            // make sure zip files like root/../../file.txt don't get extracted to 
+            // avoid zip attacks
+#ifdef GEODE_IS_WINDOWS
+            if (std::filesystem::relative((dir / filePath).wstring(), dir.wstring()).empty()) {
+#else
+            if (ghc::filesystem::relative(dir / filePath, dir).empty()) {
+#endif
+                log::error(
+                    "Zip entry '{}' is not contained within zip bounds",
+                    dir / filePath
+                );
+                continue;
+            }
+            if (entry.isDirectory) {
+                GEODE_UNWRAP(file::createDirectoryAll(dir / filePath));
+                continue;
+            }
+            GEODE_UNWRAP_INTO(
+                auto data, this->extractIndexed(entry)
+                    .expect("{error} (entry {})", filePath.string())
+            );
+            GEODE_UNWRAP(file::createDirectoryAll((dir / filePath).parent_path()));
+            GEODE_UNWRAP(file::writeBinary(dir / filePath, data).expect("Unable to write to {}: {error}", dir / filePath));
+        }
+        if (progress) {
+            progress(m_entries.size(), m_entries.size());
+        }
+        return Ok();
+    }
 
     Result<> init() {
+        if (m_mode == MZ_OPEN_MODE_READ) {
+            auto indexed = this->indexArchive();
+            if (indexed) {
+                return Ok();
+            }
+            log::debug("Reading zip through minizip: {}", indexed.unwrapErr());
+            m_entries.clear();
+            m_archive = {};
+            m_mapped.reset();
+        }
+
         // open stream from file
         if (std::holds_alternative<Path>(m_srcDest)) {
             auto& path = std::get<Path>(m_srcDest);
@@ -309,16 +923,25 @@ public:
         return Ok();
     }
 
-    Result<> extractAllTo(Path const& dir) {
+    Result<> extractAllTo(Path const& dir, file::UnzipProgress const& progress) {
         GEODE_UNWRAP(file::createDirectoryAll(dir));
 
+        if (m_indexed) {
+            return this->extractAllToIndexed(dir, progress);
+        }
+
         GEODE_UNWRAP(
             mzTry(mz_zip_goto_first_entry(m_handle))
             .expect("Unable to navigate to first entry (code {error})")
         );
 
         // while not at MZ_END_OF_LIST
+        size_t done = 0;
         do {
+            if (progress && !progress(done++, m_entries.size())) {
+                return Err("Cancelled");
+            }
+
             mz_zip_file* info = nullptr;
             if (mz_zip_entry_get_info(m_handle, &info) != MZ_OK) {
                 return Err("Unable to get entry info");
@@ -349,6 +972,9 @@ public:
             }
         } while (mz_zip_goto_next_entry(m_handle) == MZ_OK);
 
+        if (progress) {
+            progress(m_entries.size(), m_entries.size());
+        }
         return Ok();
     }
 
@@ -362,6 +988,10 @@ public:
             return Err("Entry is directory");
         }
 
+        if (m_indexed) {
+            return this->extractIndexed(entry);
+        }
+
         GEODE_UNWRAP(
             mzTry(mz_zip_goto_first_entry(m_handle))
             .expect("Unable to navigate to first entry (code {error})")
@@ -424,28 +1054,136 @@ public:
         return Ok();
     }
 
-    Result<> add(Path const& path, ByteVector const& data) {
+    Result<> writeEntry(Path const& path, ByteVector const& data, DeflatedEntry const& deflated) {
+        auto strPath = path.u8string();
+
         mz_zip_file info = { 0 };
         info.version_madeby = MZ_VERSION_MADEBY;
-        info.compression_method = MZ_COMPRESS_METHOD_DEFLATE;
-        info.filename = reinterpret_cast<const char*>(path.u8string().c_str());
+        info.compression_method = deflated.stored ? MZ_COMPRESS_METHOD_STORE : MZ_COMPRESS_METHOD_DEFLATE;
+        info.filename = reinterpret_cast<const char*>(strPath.c_str());
         info.uncompressed_size = data.size();
+        info.compressed_size = deflated.compressedSize;
+        info.crc = deflated.crc;
         info.aes_version = MZ_AES_VERSION;
 
+        // the data is already compressed so write it raw
         GEODE_UNWRAP(
-            mzTry(mz_zip_entry_write_open(m_handle, &info, MZ_COMPRESS_LEVEL_DEFAULT, 0, nullptr))
+            mzTry(mz_zip_entry_write_open(m_handle, &info, m_level, 1, nullptr))
             .expect("Unable to open entry for writing (code {error})")
         );
-        auto written = mz_zip_entry_write(m_handle, data.data(), data.size());
-        if (written < 0) {
-            mz_zip_entry_close(m_handle);
-            return Err("Unable to write entry data (code " + std::to_string(written) + ")");
+        auto write = [&](uint8_t const* buf, size_t size) -> Result<> {
+            for (size_t offset = 0; offset < size; offset += ZIP_BLOCK_SIZE) {
+                auto len = static_cast<int32_t>(std::min(ZIP_BLOCK_SIZE, size - offset));
+                auto written = mz_zip_entry_write(m_handle, buf + offset, len);
+                if (written < 0) {
+                    mz_zip_entry_close(m_handle);
+                    return Err("Unable to write entry data (code " + std::to_string(written) + ")");
+                }
+            }
+            return Ok();
+        };
+        if (deflated.stored) {
+            GEODE_UNWRAP(write(data.data(), data.size()));
         }
-        mz_zip_entry_close(m_handle);
+        else {
+            for (auto& block : deflated.blocks) {
+                GEODE_UNWRAP(write(block.data(), block.size()));
+            }
+        }
+        GEODE_UNWRAP(
+            mzTry(mz_zip_entry_close_raw(m_handle, data.size(), deflated.crc))
+            .expect("Unable to close entry (code {error})")
+        );
 
         return Ok();
     }
 
+    Result<> add(Path const& path, ByteVector const& data) {
+        GEODE_UNWRAP_INTO(
+            auto deflated,
+            deflateEntries({ &data }, m_level, resolveThreadCount(m_threads))
+        );
+        return this->writeEntry(path, data, deflated.front());
+    }
+
+    void setCompressionLevel(int level) {
+        m_level = level;
+    }
+
+    void setThreadCount(size_t count) {
+        m_threads = count;
+    }
+
+    Result<> queueFolder(Path const& path) {
+        m_pending.push_back({ path, Path(), true });
+        return Ok();
+    }
+
+    Result<> queueFile(Path const& path, Path const& file) {
+        std::error_code ec;
+        auto size = ghc::filesystem::file_size(file, ec);
+        m_pending.push_back({ path, file, false });
+        m_pendingSize += ec ? 0 : size;
+        if (m_pendingSize >= ZIP_BATCH_SIZE) {
+            return this->flushPending();
+        }
+        return Ok();
+    }
+
+    void discardPending() {
+        m_pending.clear();
+        m_pendingSize = 0;
+    }
+
+    // reads and compresses every queued file across the worker threads, then 
+    // writes the entries in the order they were queued
+    Result<> flushPending() {
+        if (m_pending.empty()) {
+            return Ok();
+        }
+        auto pending = std::move(m_pending);
+        m_pending.clear();
+        m_pendingSize = 0;
+
+        auto threads = resolveThreadCount(m_threads);
+        std::vector<ByteVector> datas(pending.size());
+        std::vector<std::string> errors(pending.size());
+        runParallel(pending.size(), threads, [&](size_t i) {
+            if (pending[i].isFolder) {
+                return;
+            }
+            auto res = file::readBinary(pending[i].file);
+            if (res) {
+                datas[i] = std::move(res.unwrap());
+            }
+            else {
+                errors[i] = res.unwrapErr();
+            }
+        });
+        for (size_t i = 0; i < pending.size(); i++) {
+            if (!errors[i].empty()) {
+                return Err("Unable to read {}: {}", pending[i].file.string(), errors[i]);
+            }
+        }
+
+        std::vector<ByteVector const*> sources;
+        sources.reserve(datas.size());
+        for (auto& data : datas) {
+            sources.push_back(&data);
+        }
+        GEODE_UNWRAP_INTO(auto deflated, deflateEntries(sources, m_level, threads));
+
+        for (size_t i = 0; i < pending.size(); i++) {
+            if (pending[i].isFolder) {
+                GEODE_UNWRAP(this->addFolder(pending[i].entry));
+            }
+            else {
+                GEODE_UNWRAP(this->writeEntry(pending[i].entry, datas[i], deflated[i]));
+            }
+        }
+        return Ok();
+    }
+
     ByteVector compressedData() const {
         if (!std::holds_alternative<ByteVector>(m_srcDest)) {
             return ByteVector();
@@ -464,10 +1202,27 @@ public:
         return Path();
     }
 
-    std::unordered_map<Path, ZipEntry> getEntries() const {
+    std::unordered_map<Path, ZipEntry> const& getEntries() const {
         return m_entries;
     }
 
+    Result<std::span<uint8_t const>> view(Path const& name) const {
+        if (!m_indexed) {
+            return Err("Zip is not memory mapped");
+        }
+        auto it = m_entries.find(name);
+        if (it == m_entries.end()) {
+            return Err("Entry not found");
+        }
+        if (it->second.isDirectory) {
+            return Err("Entry is directory");
+        }
+        if (it->second.method != MZ_COMPRESS_METHOD_STORE) {
+            return Err("Entry is compressed");
+        }
+        return this->entryData(it->second);
+    }
+
     ~Impl() {
         if (m_handle) {
             mz_zip_close(m_handle);
@@ -516,6 +1271,10 @@ Result<ByteVector> Unzip::extract(Path const& name) {
     return m_impl->extract(name).expect("{error} (entry {})", name.string());
 }
 
+Result<std::span<uint8_t const>> Unzip::view(Path const& name) const {
+    return m_impl->view(name).expect("{error} (entry {})", name.string());
+}
+
 Result<> Unzip::extractTo(Path const& name, Path const& path) {
     GEODE_UNWRAP_INTO(auto bytes, m_impl->extract(name).expect("{error} (entry {})", name.string()));
     // create containing directories for target path
@@ -527,20 +1286,33 @@ Result<> Unzip::extractTo(Path const& name, Path const& path) {
 }
 
 Result<> Unzip::extractAllTo(Path const& dir) {
-    return m_impl->extractAllTo(dir);
+    return m_impl->extractAllTo(dir, nullptr);
+}
+
+Result<> Unzip::extractAllTo(Path const& dir, UnzipProgress const& progress) {
+    return m_impl->extractAllTo(dir, progress);
 }
 
 Result<> Unzip::intoDir(
     Path const& from,
     Path const& to,
     bool deleteZipAfter
+) {
+    return Unzip::intoDir(from, to, deleteZipAfter, nullptr);
+}
+
+Result<> Unzip::intoDir(
+    Path const& from,
+    Path const& to,
+    bool deleteZipAfter,
+    UnzipProgress const& progress
 ) {
     // scope to ensure the zip is closed after extracting so the zip can be 
     // removed
     {
         GEODE_UNWRAP_INTO(auto unzip, Unzip::create(from));
         // TODO: this is quite slow lol, takes 30 seconds to extract index..
-        GEODE_UNWRAP(unzip.extractAllTo(to));
+        GEODE_UNWRAP(unzip.extractAllTo(to, progress));
     }
     if (deleteZipAfter) {
         std::error_code ec;
@@ -579,6 +1351,14 @@ ByteVector Zip::getData() const {
     return m_impl->compressedData();
 }
 
+void Zip::setCompressionLevel(int level) {
+    m_impl->setCompressionLevel(level);
+}
+
+void Zip::setThreadCount(size_t count) {
+    m_impl->setThreadCount(count);
+}
+
 Result<> Zip::add(Path const& path, ByteVector const& data) {
     return m_impl->add(path, data);
 }
@@ -593,13 +1373,14 @@ Result<> Zip::addFrom(Path const& file, Path const& entryDir) {
 }
 
 Result<> Zip::addAllFromRecurse(Path const& dir, Path const& entry) {
-    GEODE_UNWRAP(this->addFolder(entry / dir.filename()));
+    GEODE_UNWRAP(m_impl->queueFolder(entry / dir.filename()));
     for (auto& file : ghc::filesystem::directory_iterator(dir)) {
         if (ghc::filesystem::is_directory(file)) {
             GEODE_UNWRAP(this->addAllFromRecurse(file, entry / dir.filename()));
         } else {
-            GEODE_UNWRAP_INTO(auto data, file::readBinary(file));
-            GEODE_UNWRAP(this->addFrom(file, entry / dir.filename()));
+            GEODE_UNWRAP(m_impl->queueFile(
+                entry / dir.filename() / file.path().filename(), file
+            ));
         }
     }
     return Ok();
@@ -609,7 +1390,12 @@ Result<> Zip::addAllFrom(Path const& dir) {
     if (!ghc::filesystem::is_directory(dir)) {
         return Err("Path is not a directory");
     }
-    return this->addAllFromRecurse(dir, Path());
+    auto res = this->addAllFromRecurse(dir, Path());
+    if (!res) {
+        m_impl->discardPending();
+        return res;
+    }
+    return m_impl->flushPending();
 }
 
 Result<> Zip::addFolder(Path const& entry) {
@@ -666,3 +1452,245 @@ void file::unwatchFile(ghc::filesystem::path const& file) {
         return ghc::filesystem::equivalent(file, watcher->path());
     });
 }
+
+// Async
+
+namespace {
+    template <class T = geode::impl::DefaultValue, class F>
+    file::async::Task<T> runFileTask(F func, file::async::Callback<T> callback, Mod* mod) {
+        auto task = file::async::Task<T>::run(std::move(func), thread::RunOn::IO, mod);
+        if (callback) {
+            task.then([callback](Result<T> const& res) {
+                callback(res);
+            }, thread::RunOn::MainThread);
+        }
+        return task;
+    }
+
+    // Writes the whole buffer and flushes it to disk, so a rename over the 
+    // target can't leave an empty file behind after a crash
+    Result<> writeAndFlush(ghc::filesystem::path const& path, ByteVector const& data) {
+#ifdef GEODE_IS_WINDOWS
+        auto handle = CreateFileW(
+            path.wstring().c_str(), GENERIC_WRITE, 0, nullptr,
+            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr
+        );
+        if (handle == INVALID_HANDLE_VALUE) {
+            return Err("Unable to open file");
+        }
+        size_t offset = 0;
+        while (offset < data.size()) {
+            DWORD written = 0;
+            auto chunk = static_cast<DWORD>(std::min<size_t>(data.size() - offset, 1u << 30));
+            if (!WriteFile(handle, data.data() + offset, chunk, &written, nullptr)) {
+                CloseHandle(handle);
+                return Err("Unable to write file");
+            }
+            offset += written;
+        }
+        if (!FlushFileBuffers(handle)) {
+            CloseHandle(handle);
+            return Err("Unable to flush file");
+        }
+        CloseHandle(handle);
+#else
+        auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return Err("Unable to open file");
+        }
+        size_t offset = 0;
+        while (offset < data.size()) {
+            auto written = ::write(fd, data.data() + offset, data.size() - offset);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ::close(fd);
+                return Err("Unable to write file");
+            }
+            offset += static_cast<size_t>(written);
+        }
+        if (::fsync(fd) != 0) {
+            ::close(fd);
+            return Err("Unable to flush file");
+        }
+        ::close(fd);
+#endif
+        return Ok();
+    }
+
+    Result<> writeAtomic(ghc::filesystem::path const& path, ByteVector const& data) {
+        static std::atomic_size_t s_tempCounter = 0;
+        auto temp = path;
+        temp += fmt::format(".{}.tmp", s_tempCounter++);
+
+        std::error_code ec;
+        auto written = writeAndFlush(temp, data);
+        if (!written) {
+            ghc::filesystem::remove(temp, ec);
+            return written;
+        }
+#ifdef GEODE_IS_WINDOWS
+        std::filesystem::rename(temp.wstring(), path.wstring(), ec);
+#else
+        ghc::filesystem::rename(temp, path, ec);
+#endif
+        if (ec) {
+            ghc::filesystem::remove(temp, ec);
+            return Err("Unable to replace file: " + ec.message());
+        }
+        return Ok();
+    }
+
+    struct PendingWrite {
+        struct Caller {
+            // continuation of the shared write handed out to this caller, 
+            // so cancelling it only affects this caller
+            file::async::Task<> handle;
+            ByteVector data;
+        };
+        std::vector<Caller> callers;
+        std::optional<file::async::Task<>> task;
+    };
+
+    std::mutex s_writesMutex;
+    // writes that haven't started yet, which new writes to the same path 
+    // get merged into
+    std::unordered_map<ghc::filesystem::path, std::shared_ptr<PendingWrite>> s_pendingWrites;
+    // held while writing so writes to the same path happen in order
+    std::unordered_map<ghc::filesystem::path, std::weak_ptr<std::mutex>> s_writeLocks;
+}
+
+file::async::Task<std::string> file::async::readString(
+    ghc::filesystem::path const& path, Callback<std::string> callback, Mod* mod
+) {
+    return runFileTask<std::string>([path]() {
+        return file::readString(path);
+    }, std::move(callback), mod);
+}
+
+file::async::Task<matjson::Value> file::async::readJson(
+    ghc::filesystem::path const& path, Callback<matjson::Value> callback, Mod* mod
+) {
+    return runFileTask<matjson::Value>([path]() {
+        return file::readJson(path);
+    }, std::move(callback), mod);
+}
+
+file::async::Task<ByteVector> file::async::readBinary(
+    ghc::filesystem::path const& path, Callback<ByteVector> callback, Mod* mod
+) {
+    return runFileTask<ByteVector>([path]() {
+        return file::readBinary(path);
+    }, std::move(callback), mod);
+}
+
+file::async::Task<> file::async::writeString(
+    ghc::filesystem::path const& path, std::string const& data, Callback<> callback, Mod* mod
+) {
+    return file::async::writeBinary(path, ByteVector(data.begin(), data.end()), std::move(callback), mod);
+}
+
+file::async::Task<> file::async::writeBinary(
+    ghc::filesystem::path const& path, ByteVector data, Callback<> callback, Mod* mod
+) {
+    auto key = path.lexically_normal();
+
+    std::unique_lock lock(s_writesMutex);
+
+    // every caller gets its own handle, and the callback only runs if that 
+    // handle wasn't cancelled
+    auto addCaller = [&](PendingWrite& pending) {
+        auto handle = pending.task->then([](Result<> const& res) {
+            return res;
+        });
+        if (callback) {
+            handle.then([callback](Result<> const& res) {
+                callback(res);
+            }, thread::RunOn::MainThread);
+        }
+        pending.callers.push_back({ handle, std::move(data) });
+        return handle;
+    };
+
+    auto it = s_pendingWrites.find(key);
+    if (it != s_pendingWrites.end()) {
+        return addCaller(*it->second);
+    }
+
+    auto pending = std::make_shared<PendingWrite>();
+
+    std::erase_if(s_writeLocks, [](auto const& pair) { return pair.second.expired(); });
+    auto writeLock = s_writeLocks[key].lock();
+    if (!writeLock) {
+        writeLock = std::make_shared<std::mutex>();
+        s_writeLocks[key] = writeLock;
+    }
+
+    // the task can't take the pending write out of the map until this 
+    // function releases s_writesMutex
+    pending->task = Task<>::run([key, pending, writeLock]() -> Result<> {
+        std::lock_guard guard(*writeLock);
+        std::optional<ByteVector> data;
+        {
+            std::lock_guard lock(s_writesMutex);
+            auto it = s_pendingWrites.find(key);
+            if (it != s_pendingWrites.end() && it->second == pending) {
+                s_pendingWrites.erase(it);
+            }
+            // the newest data from a caller that still wants it wins
+            for (auto& caller : ranges::reverse(pending->callers)) {
+                if (!caller.handle.isCancelled()) {
+                    data = std::move(caller.data);
+                    break;
+                }
+            }
+            pending->callers.clear();
+        }
+        if (!data) {
+            return Err("Cancelled");
+        }
+        return writeAtomic(key, *data);
+    }, thread::RunOn::IO, mod);
+
+    s_pendingWrites[key] = pending;
+    return addCaller(*pending);
+}
+
+file::async::Task<std::vector<ghc::filesystem::path>> file::async::readDirectory(
+    ghc::filesystem::path const& path,
+    bool recursive,
+    Callback<std::vector<ghc::filesystem::path>> callback,
+    Mod* mod
+) {
+    return runFileTask<std::vector<ghc::filesystem::path>>([path, recursive]() {
+        return file::readDirectory(path, recursive);
+    }, std::move(callback), mod);
+}
+
+file::async::Task<> file::async::unzip(
+    ghc::filesystem::path const& from,
+    ghc::filesystem::path const& to,
+    bool deleteZipAfter,
+    Callback<> callback,
+    Progress progress,
+    Mod* mod
+) {
+    return runFileTask<>([from, to, deleteZipAfter, progress]() {
+        size_t lastPercent = 0;
+        return Unzip::intoDir(from, to, deleteZipAfter, [&](size_t done, size_t total) {
+            if (thread::isCancelled()) {
+                return false;
+            }
+            auto percent = total ? done * 100 / total : 100;
+            // the final call always goes through so callers see it finish
+            if (progress && (percent != lastPercent || done == total)) {
+                lastPercent = percent;
+                Loader::get()->queueInMainThread([progress, done, total]() {
+                    progress(done, total);
+                });
+            }
+            return true;
+        });
+    }, std::move(callback), mod);
+}
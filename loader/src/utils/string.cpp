@@ -1,5 +1,15 @@
 #include <Geode/utils/string.hpp>
 #include <algorithm>
+#include <cctype>
+#include <cwctype>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GEODE_STRING_SSE2
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define GEODE_STRING_NEON
+#endif
 
 using namespace geode::prelude;
 
@@ -25,28 +35,167 @@ std::wstring utils::string::utf8ToWide(std::string const& str) {
 
 #endif
 
-bool utils::string::startsWith(std::string const& str, std::string const& prefix) {
-    return str.rfind(prefix, 0) == 0;
+// flips the case of every char in [first, last], which for the ascii
+// letter ranges is just toggling 0x20
+static void flipAsciiCase(char* data, size_t size, char first, char last) {
+    size_t i = 0;
+#if defined(GEODE_STRING_SSE2)
+    auto const below = _mm_set1_epi8(first - 1);
+    auto const above = _mm_set1_epi8(last + 1);
+    auto const bit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= size; i += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+        // signed compares are fine here, non-ascii bytes are negative
+        // and so never fall in the range
+        auto inRange = _mm_and_si128(_mm_cmpgt_epi8(chunk, below), _mm_cmplt_epi8(chunk, above));
+        chunk = _mm_xor_si128(chunk, _mm_and_si128(inRange, bit));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), chunk);
+    }
+#elif defined(GEODE_STRING_NEON)
+    auto const lower = vdupq_n_u8(static_cast<uint8_t>(first));
+    auto const upper = vdupq_n_u8(static_cast<uint8_t>(last));
+    auto const bit = vdupq_n_u8(0x20);
+    for (; i + 16 <= size; i += 16) {
+        auto chunk = vld1q_u8(reinterpret_cast<uint8_t const*>(data + i));
+        auto inRange = vandq_u8(vcgeq_u8(chunk, lower), vcleq_u8(chunk, upper));
+        chunk = veorq_u8(chunk, vandq_u8(inRange, bit));
+        vst1q_u8(reinterpret_cast<uint8_t*>(data + i), chunk);
+    }
+#endif
+    for (; i < size; i++) {
+        if (data[i] >= first && data[i] <= last) {
+            data[i] ^= 0x20;
+        }
+    }
 }
 
-bool utils::string::startsWith(std::wstring const& str, std::wstring const& prefix) {
-    return str.rfind(prefix, 0) == 0;
+static char asciiToLower(char c) {
+    return c >= 'A' && c <= 'Z' ? c ^ 0x20 : c;
 }
 
-bool utils::string::endsWith(std::string const& str, std::string const& suffix) {
+template <class Char>
+static void replaceInto(
+    std::basic_string<Char>& out, std::basic_string_view<Char> str,
+    std::basic_string_view<Char> orig, std::basic_string_view<Char> repl
+) {
+    out.reserve(str.size());
+    size_t pos = 0;
+    size_t n;
+    while ((n = str.find(orig, pos)) != std::basic_string_view<Char>::npos) {
+        out.append(str.substr(pos, n - pos));
+        out.append(repl);
+        pos = n + orig.size();
+    }
+    out.append(str.substr(pos));
+}
+
+template <class Char>
+static std::basic_string<Char>& replaceInPlace(
+    std::basic_string<Char>& str, std::basic_string_view<Char> orig,
+    std::basic_string_view<Char> repl
+) {
+    if (orig.empty()) return str;
+    // find the first match before allocating anything, most calls don't replace anything
+    auto const first = std::basic_string_view<Char>(str).find(orig);
+    if (first == std::basic_string_view<Char>::npos) return str;
+
+    // orig and repl may point into str, so build into a separate string
+    std::basic_string<Char> out;
+    out.reserve(str.size());
+    out.append(str, 0, first);
+    out.append(repl);
+    replaceInto(out, std::basic_string_view<Char>(str).substr(first + orig.size()), orig, repl);
+    str = std::move(out);
+    return str;
+}
+
+template <class Char>
+static std::vector<std::basic_string<Char>> splitToVector(
+    std::basic_string_view<Char> str, std::basic_string_view<Char> split
+) {
+    std::vector<std::basic_string<Char>> res;
+    for (auto part : utils::string::BasicSplitView<Char>(str, split)) {
+        res.emplace_back(part);
+    }
+    return res;
+}
+
+template <class Char>
+static std::basic_string<Char> joinVector(
+    std::vector<std::basic_string<Char>> const& strs, std::basic_string_view<Char> separator
+) {
+    std::basic_string<Char> res;
+    if (strs.empty())
+        return res;
+    if (strs.size() == 1)
+        return strs[0];
+    size_t size = separator.size() * (strs.size() - 1);
+    for (auto const& str : strs)
+        size += str.size();
+    res.reserve(size);
+    res += strs[0];
+    for (size_t i = 1; i < strs.size(); i++) {
+        res += separator;
+        res += strs[i];
+    }
+    return res;
+}
+
+static bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c));
+}
+static bool isSpace(wchar_t c) {
+    return std::iswspace(c);
+}
+
+template <class Char>
+static std::basic_string_view<Char> trimLeftView(std::basic_string_view<Char> str) {
+    auto it = std::find_if(str.begin(), str.end(), [](Char ch) {
+        return !isSpace(ch);
+    });
+    return str.substr(it - str.begin());
+}
+
+template <class Char>
+static std::basic_string_view<Char> trimRightView(std::basic_string_view<Char> str) {
+    auto it = std::find_if(str.rbegin(), str.rend(), [](Char ch) {
+        return !isSpace(ch);
+    });
+    return str.substr(0, str.rend() - it);
+}
+
+template <class Char>
+static std::basic_string<Char>& normalizeInPlace(std::basic_string<Char>& str) {
+    // collapse every run of spaces into a single one
+    str.erase(
+        std::unique(str.begin(), str.end(), [](Char a, Char b) {
+            return a == ' ' && b == ' ';
+        }),
+        str.end()
+    );
+    return str;
+}
+
+bool utils::string::startsWith(std::string_view str, std::string_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+bool utils::string::startsWith(std::wstring_view str, std::wstring_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+bool utils::string::endsWith(std::string_view str, std::string_view suffix) {
     if (suffix.size() > str.size()) return false;
-    return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin());
+    return str.substr(str.size() - suffix.size()) == suffix;
 }
 
-bool utils::string::endsWith(std::wstring const& str, std::wstring const& suffix) {
+bool utils::string::endsWith(std::wstring_view str, std::wstring_view suffix) {
     if (suffix.size() > str.size()) return false;
-    return std::equal(suffix.rbegin(), suffix.rend(), str.rbegin());
+    return str.substr(str.size() - suffix.size()) == suffix;
 }
 
 std::string& utils::string::toLowerIP(std::string& str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](auto c) {
-        return std::tolower(c);
-    });
+    flipAsciiCase(str.data(), str.size(), 'A', 'Z');
     return str;
 }
 
@@ -57,20 +206,18 @@ std::wstring& utils::string::toLowerIP(std::wstring& str) {
     return str;
 }
 
-std::string utils::string::toLower(std::string const& str) {
-    std::string ret = str;
+std::string utils::string::toLower(std::string_view str) {
+    std::string ret(str);
     return utils::string::toLowerIP(ret);
 }
 
-std::wstring utils::string::toLower(std::wstring const& str) {
-    std::wstring ret = str;
+std::wstring utils::string::toLower(std::wstring_view str) {
+    std::wstring ret(str);
     return utils::string::toLowerIP(ret);
 }
 
 std::string& utils::string::toUpperIP(std::string& str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](auto c) {
-        return std::toupper(c);
-    });
+    flipAsciiCase(str.data(), str.size(), 'a', 'z');
     return str;
 }
 
@@ -81,225 +228,154 @@ std::wstring& utils::string::toUpperIP(std::wstring& str) {
     return str;
 }
 
-std::string utils::string::toUpper(std::string const& str) {
-    std::string ret = str;
+std::string utils::string::toUpper(std::string_view str) {
+    std::string ret(str);
     return utils::string::toUpperIP(ret);
 }
 
-std::wstring utils::string::toUpper(std::wstring const& str) {
-    std::wstring ret = str;
+std::wstring utils::string::toUpper(std::wstring_view str) {
+    std::wstring ret(str);
     return utils::string::toUpperIP(ret);
 }
 
-std::string& utils::string::replaceIP(std::string& str, std::string const& orig, std::string const& repl) {
-    std::string::size_type n = 0;
-    while ((n = str.find(orig, n)) != std::string::npos) {
-        str.replace(n, orig.size(), repl);
-        n += repl.size();
-    }
-    return str;
+std::string& utils::string::replaceIP(std::string& str, std::string_view orig, std::string_view repl) {
+    return replaceInPlace(str, orig, repl);
 }
 
 std::wstring& utils::string::replaceIP(
-    std::wstring& str, std::wstring const& orig, std::wstring const& repl
+    std::wstring& str, std::wstring_view orig, std::wstring_view repl
 ) {
-    std::wstring::size_type n = 0;
-    while ((n = str.find(orig, n)) != std::wstring::npos) {
-        str.replace(n, orig.size(), repl);
-        n += repl.size();
-    }
-    return str;
+    return replaceInPlace(str, orig, repl);
 }
 
 std::string utils::string::replace(
-    std::string const& str, std::string const& orig, std::string const& repl
+    std::string_view str, std::string_view orig, std::string_view repl
 ) {
-    auto ret = str;
-    return utils::string::replaceIP(ret, orig, repl);
+    if (orig.empty()) return std::string(str);
+    std::string ret;
+    replaceInto(ret, str, orig, repl);
+    return ret;
 }
 
 std::wstring utils::string::replace(
-    std::wstring const& str, std::wstring const& orig, std::wstring const& repl
+    std::wstring_view str, std::wstring_view orig, std::wstring_view repl
 ) {
-    auto ret = str;
-    return utils::string::replaceIP(ret, orig, repl);
+    if (orig.empty()) return std::wstring(str);
+    std::wstring ret;
+    replaceInto(ret, str, orig, repl);
+    return ret;
 }
 
-std::vector<std::string> utils::string::split(std::string const& str, std::string const& split) {
-    std::vector<std::string> res;
-    if (str.empty()) return res;
-    auto s = str;
-    size_t pos;
-    while ((pos = s.find(split)) != std::string::npos) {
-        res.push_back(s.substr(0, pos));
-        s.erase(0, pos + split.length());
-    }
-    res.push_back(s);
-    return res;
+std::vector<std::string> utils::string::split(std::string_view str, std::string_view split) {
+    return splitToVector(str, split);
 }
 
-std::vector<std::wstring> utils::string::split(std::wstring const& str, std::wstring const& split) {
-    std::vector<std::wstring> res;
-    if (str.empty()) return res;
-    auto s = str;
-    size_t pos;
-    while ((pos = s.find(split)) != std::wstring::npos) {
-        res.push_back(s.substr(0, pos));
-        s.erase(0, pos + split.length());
-    }
-    res.push_back(s);
-        return res;
+std::vector<std::wstring> utils::string::split(std::wstring_view str, std::wstring_view split) {
+    return splitToVector(str, split);
 }
 
-std::string utils::string::join(std::vector<std::string> const& strs, std::string const& separator) {
-    std::string res;
-    if (strs.empty())
-        return res;
-    if (strs.size() == 1)
-        return strs[0];
-    // idk if less allocations but an extra loop is faster but
-    size_t size = 0;
-    for (auto const& str : strs)
-        size += str.size() + separator.size();
-    res.reserve(size);
-    for (auto const& str : strs)
-        res += str + separator;
-    res.erase(res.size() - separator.size());
-    return res;
+std::string utils::string::join(std::vector<std::string> const& strs, std::string_view separator) {
+    return joinVector(strs, separator);
 }
 
-std::wstring utils::string::join(std::vector<std::wstring> const& strs, std::wstring const& separator) {
-    std::wstring res;
-    if (strs.empty())
-        return res;
-    if (strs.size() == 1)
-        return strs[0];
-    // idk if less allocations but an extra loop is faster but
-    size_t size = 0;
-    for (auto const& str : strs)
-        size += str.size() + separator.size();
-    res.reserve(size);
-    for (auto const& str : strs)
-        res += str + separator;
-    res.erase(res.size() - separator.size());
-    return res;
+std::wstring utils::string::join(std::vector<std::wstring> const& strs, std::wstring_view separator) {
+    return joinVector(strs, separator);
 }
 
-std::vector<char> utils::string::split(std::string const& str) {
-    std::vector<char> res;
-    for (auto const& s : str) {
-        res.push_back(s);
-    }
-    return res;
+std::vector<char> utils::string::split(std::string_view str) {
+    return std::vector<char>(str.begin(), str.end());
 }
 
-std::vector<wchar_t> utils::string::split(std::wstring const& str) {
-    std::vector<wchar_t> res;
-    for (auto const& s : str) {
-        res.push_back(s);
-    }
-    return res;
+std::vector<wchar_t> utils::string::split(std::wstring_view str) {
+    return std::vector<wchar_t>(str.begin(), str.end());
 }
 
-bool utils::string::contains(std::string const& str, std::string const& subs) {
-    return str.find(subs) != std::string::npos;
+bool utils::string::contains(std::string_view str, std::string_view subs) {
+    return str.find(subs) != std::string_view::npos;
 }
 
-bool utils::string::contains(std::wstring const& str, std::wstring const& subs) {
-    return str.find(subs) != std::wstring::npos;
+bool utils::string::contains(std::wstring_view str, std::wstring_view subs) {
+    return str.find(subs) != std::wstring_view::npos;
 }
 
-bool utils::string::contains(std::string const& str, std::string::value_type c) {
-    return str.find(c) != std::string::npos;
+bool utils::string::contains(std::string_view str, char c) {
+    return str.find(c) != std::string_view::npos;
 }
 
-bool utils::string::contains(std::wstring const& str, std::wstring::value_type c) {
-    return str.find(c) != std::wstring::npos;
+bool utils::string::contains(std::wstring_view str, wchar_t c) {
+    return str.find(c) != std::wstring_view::npos;
 }
 
-bool utils::string::containsAny(std::string const& str, std::vector<std::string> const& subs) {
+bool utils::string::containsIgnoreCase(std::string_view str, std::string_view subs) {
+    if (subs.empty()) return true;
+    if (subs.size() > str.size()) return false;
+
+    auto const first = asciiToLower(subs[0]);
+    for (size_t i = 0; i + subs.size() <= str.size(); i++) {
+        // cheap first char check before comparing the whole thing
+        if (asciiToLower(str[i]) != first) continue;
+        size_t j = 1;
+        while (j < subs.size() && asciiToLower(str[i + j]) == asciiToLower(subs[j])) {
+            j++;
+        }
+        if (j == subs.size()) return true;
+    }
+    return false;
+}
+
+bool utils::string::containsAny(std::string_view str, std::vector<std::string> const& subs) {
     for (auto const& sub : subs) {
         if (utils::string::contains(str, sub)) return true;
     }
     return false;
 }
 
-bool utils::string::containsAny(std::wstring const& str, std::vector<std::wstring> const& subs) {
+bool utils::string::containsAny(std::wstring_view str, std::vector<std::wstring> const& subs) {
     for (auto const& sub : subs) {
         if (utils::string::contains(str, sub)) return true;
     }
     return false;
 }
 
-bool utils::string::containsAll(std::string const& str, std::vector<std::string> const& subs) {
-    bool found = true;
+bool utils::string::containsAll(std::string_view str, std::vector<std::string> const& subs) {
     for (auto const& sub : subs) {
-        if (!utils::string::contains(str, sub)) found = false;
+        if (!utils::string::contains(str, sub)) return false;
     }
-    return found;
+    return true;
 }
 
-bool utils::string::containsAll(std::wstring const& str, std::vector<std::wstring> const& subs) {
-    bool found = true;
+bool utils::string::containsAll(std::wstring_view str, std::vector<std::wstring> const& subs) {
     for (auto const& sub : subs) {
-        if (!utils::string::contains(str, sub)) found = false;
+        if (!utils::string::contains(str, sub)) return false;
     }
-    return found;
+    return true;
 }
 
-size_t utils::string::count(std::string const& str, char countC) {
-    size_t res = 0;
-    for (auto c : str)
-        if (c == countC) res++;
-    return res;
+size_t utils::string::count(std::string_view str, char countC) {
+    return std::count(str.begin(), str.end(), countC);
 }
 
-size_t utils::string::count(std::wstring const& str, wchar_t countC) {
-    size_t res = 0;
-    for (auto c : str)
-        if (c == countC) res++;
-    return res;
+size_t utils::string::count(std::wstring_view str, wchar_t countC) {
+    return std::count(str.begin(), str.end(), countC);
 }
 
 std::string& utils::string::trimLeftIP(std::string& str) {
-    str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](auto ch) {
-                  return !std::isspace(ch);
-              }));
+    str.erase(0, str.size() - trimLeftView<char>(str).size());
     return str;
 }
 
 std::wstring& utils::string::trimLeftIP(std::wstring& str) {
-    str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](auto ch) {
-                  return !std::isspace(ch);
-              }));
+    str.erase(0, str.size() - trimLeftView<wchar_t>(str).size());
     return str;
 }
 
 std::string& utils::string::trimRightIP(std::string& str) {
-    str.erase(
-        std::find_if(
-            str.rbegin(),
-            str.rend(),
-            [](auto ch) {
-                return !std::isspace(ch);
-            }
-        ).base(),
-        str.end()
-    );
+    str.erase(trimRightView<char>(str).size());
     return str;
 }
 
 std::wstring& utils::string::trimRightIP(std::wstring& str) {
-    str.erase(
-        std::find_if(
-            str.rbegin(),
-            str.rend(),
-            [](auto ch) {
-                return !std::isspace(ch);
-            }
-        ).base(),
-        str.end()
-    );
+    str.erase(trimRightView<wchar_t>(str).size());
     return str;
 }
 
@@ -311,54 +387,230 @@ std::wstring& utils::string::trimIP(std::wstring& str) {
     return utils::string::trimLeftIP(utils::string::trimRightIP(str));
 }
 
-std::string utils::string::trimLeft(std::string const& str) {
-    auto s2 = str;
-    return utils::string::trimLeftIP(s2);
+std::string utils::string::trimLeft(std::string_view str) {
+    return std::string(trimLeftView(str));
 }
 
-std::wstring utils::string::trimLeft(std::wstring const& str) {
-    auto s2 = str;
-    return utils::string::trimLeftIP(s2);
+std::wstring utils::string::trimLeft(std::wstring_view str) {
+    return std::wstring(trimLeftView(str));
 }
 
-std::string utils::string::trimRight(std::string const& str) {
-    auto ret = str;
-    return utils::string::trimRightIP(ret);
+std::string utils::string::trimRight(std::string_view str) {
+    return std::string(trimRightView(str));
 }
 
-std::wstring utils::string::trimRight(std::wstring const& str) {
-    auto ret = str;
-    return utils::string::trimRightIP(ret);
+std::wstring utils::string::trimRight(std::wstring_view str) {
+    return std::wstring(trimRightView(str));
 }
 
-std::string utils::string::trim(std::string const& str) {
-    auto ret = str;
-    return utils::string::trimIP(ret);
+std::string utils::string::trim(std::string_view str) {
+    return std::string(trimLeftView(trimRightView(str)));
 }
 
-std::wstring utils::string::trim(std::wstring const& str) {
-    auto ret = str;
-    return utils::string::trimIP(ret);
+std::wstring utils::string::trim(std::wstring_view str) {
+    return std::wstring(trimLeftView(trimRightView(str)));
 }
 
 std::string& utils::string::normalizeIP(std::string& str) {
-    while (utils::string::contains(str, "  "))
-        utils::string::replaceIP(str, "  ", " ");
-    return str;
+    return normalizeInPlace(str);
 }
 
 std::wstring& utils::string::normalizeIP(std::wstring& str) {
-    while (utils::string::contains(str, L"  "))
-        utils::string::replaceIP(str, L"  ", L" ");
-    return str;
+    return normalizeInPlace(str);
+}
+
+std::string utils::string::normalize(std::string_view str) {
+    std::string ret(str);
+    return normalizeInPlace(ret);
+}
+
+std::wstring utils::string::normalize(std::wstring_view str) {
+    std::wstring ret(str);
+    return normalizeInPlace(ret);
+}
+
+// these used to take std::string const&, and are kept so that mods built
+// against those signatures still link. they aren't in the header, as
+// calls with only string literals would be ambiguous with the views
+namespace geode::utils::string {
+    GEODE_DLL std::string toLower(std::string const& str);
+    GEODE_DLL std::string toUpper(std::string const& str);
+    GEODE_DLL std::string& replaceIP(std::string& str, std::string const& orig, std::string const& repl);
+    GEODE_DLL std::string replace(std::string const& str, std::string const& orig, std::string const& repl);
+    GEODE_DLL std::vector<std::string> split(std::string const& str, std::string const& split);
+    GEODE_DLL std::string join(std::vector<std::string> const& strs, std::string const& separator);
+    GEODE_DLL std::vector<char> split(std::string const& str);
+    GEODE_DLL bool contains(std::string const& str, std::string const& subs);
+    GEODE_DLL bool contains(std::string const& str, char c);
+    GEODE_DLL bool containsAny(std::string const& str, std::vector<std::string> const& subs);
+    GEODE_DLL bool containsAll(std::string const& str, std::vector<std::string> const& subs);
+    GEODE_DLL size_t count(std::string const& str, char c);
+    GEODE_DLL std::string trimLeft(std::string const& str);
+    GEODE_DLL std::string trimRight(std::string const& str);
+    GEODE_DLL std::string trim(std::string const& str);
+    GEODE_DLL std::string normalize(std::string const& str);
+    GEODE_DLL bool startsWith(std::string const& str, std::string const& prefix);
+    GEODE_DLL bool endsWith(std::string const& str, std::string const& suffix);
+    GEODE_DLL std::wstring toLower(std::wstring const& str);
+    GEODE_DLL std::wstring toUpper(std::wstring const& str);
+    GEODE_DLL std::wstring& replaceIP(std::wstring& str, std::wstring const& orig, std::wstring const& repl);
+    GEODE_DLL std::wstring replace(std::wstring const& str, std::wstring const& orig, std::wstring const& repl);
+    GEODE_DLL std::vector<std::wstring> split(std::wstring const& str, std::wstring const& split);
+    GEODE_DLL std::wstring join(std::vector<std::wstring> const& strs, std::wstring const& separator);
+    GEODE_DLL std::vector<wchar_t> split(std::wstring const& str);
+    GEODE_DLL bool contains(std::wstring const& str, std::wstring const& subs);
+    GEODE_DLL bool contains(std::wstring const& str, wchar_t c);
+    GEODE_DLL bool containsAny(std::wstring const& str, std::vector<std::wstring> const& subs);
+    GEODE_DLL bool containsAll(std::wstring const& str, std::vector<std::wstring> const& subs);
+    GEODE_DLL size_t count(std::wstring const& str, wchar_t c);
+    GEODE_DLL std::wstring trimLeft(std::wstring const& str);
+    GEODE_DLL std::wstring trimRight(std::wstring const& str);
+    GEODE_DLL std::wstring trim(std::wstring const& str);
+    GEODE_DLL std::wstring normalize(std::wstring const& str);
+    GEODE_DLL bool startsWith(std::wstring const& str, std::wstring const& prefix);
+    GEODE_DLL bool endsWith(std::wstring const& str, std::wstring const& suffix);
+}
+
+std::string utils::string::toLower(std::string const& str) {
+    return utils::string::toLower(std::string_view(str));
+}
+
+std::string utils::string::toUpper(std::string const& str) {
+    return utils::string::toUpper(std::string_view(str));
+}
+
+std::string& utils::string::replaceIP(std::string& str, std::string const& orig, std::string const& repl) {
+    return utils::string::replaceIP(str, std::string_view(orig), std::string_view(repl));
+}
+
+std::string utils::string::replace(std::string const& str, std::string const& orig, std::string const& repl) {
+    return utils::string::replace(std::string_view(str), std::string_view(orig), std::string_view(repl));
+}
+
+std::vector<std::string> utils::string::split(std::string const& str, std::string const& split) {
+    return utils::string::split(std::string_view(str), std::string_view(split));
+}
+
+std::string utils::string::join(std::vector<std::string> const& strs, std::string const& separator) {
+    return utils::string::join(strs, std::string_view(separator));
+}
+
+std::vector<char> utils::string::split(std::string const& str) {
+    return utils::string::split(std::string_view(str));
+}
+
+bool utils::string::contains(std::string const& str, std::string const& subs) {
+    return utils::string::contains(std::string_view(str), std::string_view(subs));
+}
+
+bool utils::string::contains(std::string const& str, char c) {
+    return utils::string::contains(std::string_view(str), c);
+}
+
+bool utils::string::containsAny(std::string const& str, std::vector<std::string> const& subs) {
+    return utils::string::containsAny(std::string_view(str), subs);
+}
+
+bool utils::string::containsAll(std::string const& str, std::vector<std::string> const& subs) {
+    return utils::string::containsAll(std::string_view(str), subs);
+}
+
+size_t utils::string::count(std::string const& str, char c) {
+    return utils::string::count(std::string_view(str), c);
+}
+
+std::string utils::string::trimLeft(std::string const& str) {
+    return utils::string::trimLeft(std::string_view(str));
+}
+
+std::string utils::string::trimRight(std::string const& str) {
+    return utils::string::trimRight(std::string_view(str));
+}
+
+std::string utils::string::trim(std::string const& str) {
+    return utils::string::trim(std::string_view(str));
 }
 
 std::string utils::string::normalize(std::string const& str) {
-    auto ret = str;
-    return utils::string::normalizeIP(ret);
+    return utils::string::normalize(std::string_view(str));
+}
+
+bool utils::string::startsWith(std::string const& str, std::string const& prefix) {
+    return utils::string::startsWith(std::string_view(str), std::string_view(prefix));
+}
+
+bool utils::string::endsWith(std::string const& str, std::string const& suffix) {
+    return utils::string::endsWith(std::string_view(str), std::string_view(suffix));
+}
+
+std::wstring utils::string::toLower(std::wstring const& str) {
+    return utils::string::toLower(std::wstring_view(str));
+}
+
+std::wstring utils::string::toUpper(std::wstring const& str) {
+    return utils::string::toUpper(std::wstring_view(str));
+}
+
+std::wstring& utils::string::replaceIP(std::wstring& str, std::wstring const& orig, std::wstring const& repl) {
+    return utils::string::replaceIP(str, std::wstring_view(orig), std::wstring_view(repl));
+}
+
+std::wstring utils::string::replace(std::wstring const& str, std::wstring const& orig, std::wstring const& repl) {
+    return utils::string::replace(std::wstring_view(str), std::wstring_view(orig), std::wstring_view(repl));
+}
+
+std::vector<std::wstring> utils::string::split(std::wstring const& str, std::wstring const& split) {
+    return utils::string::split(std::wstring_view(str), std::wstring_view(split));
+}
+
+std::wstring utils::string::join(std::vector<std::wstring> const& strs, std::wstring const& separator) {
+    return utils::string::join(strs, std::wstring_view(separator));
+}
+
+std::vector<wchar_t> utils::string::split(std::wstring const& str) {
+    return utils::string::split(std::wstring_view(str));
+}
+
+bool utils::string::contains(std::wstring const& str, std::wstring const& subs) {
+    return utils::string::contains(std::wstring_view(str), std::wstring_view(subs));
+}
+
+bool utils::string::contains(std::wstring const& str, wchar_t c) {
+    return utils::string::contains(std::wstring_view(str), c);
+}
+
+bool utils::string::containsAny(std::wstring const& str, std::vector<std::wstring> const& subs) {
+    return utils::string::containsAny(std::wstring_view(str), subs);
+}
+
+bool utils::string::containsAll(std::wstring const& str, std::vector<std::wstring> const& subs) {
+    return utils::string::containsAll(std::wstring_view(str), subs);
+}
+
+size_t utils::string::count(std::wstring const& str, wchar_t c) {
+    return utils::string::count(std::wstring_view(str), c);
+}
+
+std::wstring utils::string::trimLeft(std::wstring const& str) {
+    return utils::string::trimLeft(std::wstring_view(str));
+}
+
+std::wstring utils::string::trimRight(std::wstring const& str) {
+    return utils::string::trimRight(std::wstring_view(str));
+}
+
+std::wstring utils::string::trim(std::wstring const& str) {
+    return utils::string::trim(std::wstring_view(str));
 }
 
 std::wstring utils::string::normalize(std::wstring const& str) {
-    auto ret = str;
-    return utils::string::normalizeIP(ret);
+    return utils::string::normalize(std::wstring_view(str));
+}
+
+bool utils::string::startsWith(std::wstring const& str, std::wstring const& prefix) {
+    return utils::string::startsWith(std::wstring_view(str), std::wstring_view(prefix));
+}
+
+bool utils::string::endsWith(std::wstring const& str, std::wstring const& suffix) {
+    return utils::string::endsWith(std::wstring_view(str), std::wstring_view(suffix));
 }
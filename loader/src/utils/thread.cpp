@@ -0,0 +1,273 @@
+#include <Geode/loader/Loader.hpp>
+#include <Geode/utils/thread.hpp>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+
+using namespace geode::prelude;
+using namespace geode::utils::thread;
+
+void utils::thread::impl::TaskStateBase::finish(std::unique_lock<std::mutex>& lock) {
+    m_done = true;
+    auto continuations = std::move(m_continuations);
+    m_continuations.clear();
+    lock.unlock();
+    m_cv.notify_all();
+    for (auto& func : continuations) {
+        func();
+    }
+}
+
+bool utils::thread::impl::TaskStateBase::isCancelled() const {
+    return m_cancelled;
+}
+
+bool utils::thread::impl::TaskStateBase::isDone() {
+    std::unique_lock lock(m_mutex);
+    return m_done;
+}
+
+void utils::thread::impl::TaskStateBase::cancel() {
+    std::unique_lock lock(m_mutex);
+    m_cancelled = true;
+    if (!m_done) {
+        this->finish(lock);
+    }
+}
+
+void utils::thread::impl::TaskStateBase::fail(std::exception_ptr exception) {
+    std::unique_lock lock(m_mutex);
+    if (m_done) return;
+    m_exception = exception;
+    this->finish(lock);
+}
+
+void utils::thread::impl::TaskStateBase::wait() {
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_done; });
+}
+
+void utils::thread::impl::TaskStateBase::rethrow() {
+    std::unique_lock lock(m_mutex);
+    if (m_exception) {
+        std::rethrow_exception(m_exception);
+    }
+}
+
+void utils::thread::impl::TaskStateBase::onDone(MiniFunction<void()> func) {
+    std::unique_lock lock(m_mutex);
+    if (m_done) {
+        lock.unlock();
+        func();
+        return;
+    }
+    m_continuations.push_back(std::move(func));
+}
+
+namespace {
+    struct Counters {
+        std::atomic<size_t> queued = 0;
+        std::atomic<size_t> running = 0;
+        std::atomic<size_t> completed = 0;
+        std::atomic<size_t> cancelled = 0;
+    };
+
+    struct Job {
+        std::shared_ptr<utils::thread::impl::TaskStateBase> state;
+        MiniFunction<void()> func;
+        Counters* counters;
+    };
+
+    thread_local utils::thread::impl::TaskStateBase* s_currentTask = nullptr;
+
+    void runJob(Job& job) {
+        job.counters->queued -= 1;
+        if (job.state->isCancelled()) {
+            job.counters->cancelled += 1;
+            return;
+        }
+        job.counters->running += 1;
+        auto prev = s_currentTask;
+        s_currentTask = job.state.get();
+        job.func();
+        s_currentTask = prev;
+        job.counters->running -= 1;
+        job.counters->completed += 1;
+    }
+
+    // Each worker owns a deque: it pushes and pops at the back, and idle
+    // workers steal from the front of the others
+    class Pool final {
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCV;
+        std::atomic<size_t> m_pending = 0;
+        std::atomic<size_t> m_nextQueue = 0;
+
+        std::mutex m_countersMutex;
+        std::unordered_map<Mod*, std::unique_ptr<Counters>> m_counters;
+
+        static inline thread_local Pool* s_pool = nullptr;
+        static inline thread_local size_t s_index = 0;
+
+        Pool(size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            for (size_t i = 0; i < count; i++) {
+                std::thread(&Pool::work, this, i).detach();
+            }
+        }
+
+        std::optional<Job> take(size_t index) {
+            {
+                auto& own = *m_queues[index];
+                std::lock_guard lock(own.mutex);
+                if (!own.jobs.empty()) {
+                    auto job = std::move(own.jobs.back());
+                    own.jobs.pop_back();
+                    return job;
+                }
+            }
+            for (size_t i = 1; i < m_queues.size(); i++) {
+                auto& other = *m_queues[(index + i) % m_queues.size()];
+                std::lock_guard lock(other.mutex);
+                if (!other.jobs.empty()) {
+                    auto job = std::move(other.jobs.front());
+                    other.jobs.pop_front();
+                    return job;
+                }
+            }
+            return std::nullopt;
+        }
+
+        void work(size_t index) {
+            s_pool = this;
+            s_index = index;
+            while (true) {
+                if (auto job = this->take(index)) {
+                    m_pending -= 1;
+                    runJob(*job);
+                    continue;
+                }
+                std::unique_lock lock(m_sleepMutex);
+                m_sleepCV.wait(lock, [this] { return m_pending > 0; });
+            }
+        }
+
+    public:
+        static Pool* get() {
+            // never destroyed, as the workers are detached
+            static auto inst = new Pool(std::max(std::thread::hardware_concurrency(), 2u));
+            return inst;
+        }
+
+        // blocking I/O spends most of its time waiting, so this doesn't 
+        // need to scale with the core count. it only owns its workers, the 
+        // stats of every task are still kept by the shared pool
+        static Pool* io() {
+            static auto inst = new Pool(4);
+            return inst;
+        }
+
+        Counters* countersFor(Mod* mod) {
+            std::lock_guard lock(m_countersMutex);
+            auto& counters = m_counters[mod];
+            if (!counters) {
+                counters = std::make_unique<Counters>();
+            }
+            return counters.get();
+        }
+
+        TaskStats stats(Mod* mod) {
+            std::lock_guard lock(m_countersMutex);
+            auto it = m_counters.find(mod);
+            if (it == m_counters.end()) {
+                return TaskStats();
+            }
+            return TaskStats {
+                .queued = it->second->queued,
+                .running = it->second->running,
+                .completed = it->second->completed,
+                .cancelled = it->second->cancelled,
+            };
+        }
+
+        void push(Job&& job) {
+            // tasks spawned from a worker stay on that worker's queue so
+            // they run while its data is still hot
+            auto index = s_pool == this ?
+                s_index :
+                m_nextQueue.fetch_add(1) % m_queues.size();
+            // counted before it becomes visible so a worker taking it can't
+            // underflow the counter
+            m_pending += 1;
+            {
+                auto& queue = *m_queues[index];
+                std::lock_guard lock(queue.mutex);
+                queue.jobs.push_back(std::move(job));
+            }
+            {
+                std::lock_guard lock(m_sleepMutex);
+            }
+            m_sleepCV.notify_one();
+        }
+
+        size_t workerCount() const {
+            return m_queues.size();
+        }
+
+        bool isWorker() const {
+            return s_pool == this;
+        }
+    };
+}
+
+void utils::thread::impl::post(
+    std::shared_ptr<TaskStateBase> state, RunOn target, MiniFunction<void()> func
+) {
+    auto pool = Pool::get();
+    auto counters = pool->countersFor(state->mod);
+    counters->queued += 1;
+    Job job {
+        .state = std::move(state),
+        .func = std::move(func),
+        .counters = counters,
+    };
+    switch (target) {
+        case RunOn::Pool: {
+            pool->push(std::move(job));
+        } break;
+
+        case RunOn::MainThread: {
+            Loader::get()->queueInMainThread([job]() mutable {
+                runJob(job);
+            });
+        } break;
+
+        case RunOn::IO: {
+            Pool::io()->push(std::move(job));
+        } break;
+    }
+}
+
+bool utils::thread::isCancelled() {
+    return s_currentTask && s_currentTask->isCancelled();
+}
+
+size_t utils::thread::getWorkerCount() {
+    return Pool::get()->workerCount();
+}
+
+bool utils::thread::isWorkerThread() {
+    return Pool::get()->isWorker();
+}
+
+TaskStats utils::thread::getStats(Mod* mod) {
+    return Pool::get()->stats(mod);
+}
@@ -1,8 +1,12 @@
 #include <Geode/cocos/platform/IncludeCurl.h>
 #include <Geode/loader/Loader.hpp>
 #include <Geode/utils/casts.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/string.hpp>
 #include <Geode/utils/web.hpp>
 #include <matjson.hpp>
+#include <array>
+#include <atomic>
 #include <thread>
 
 using namespace geode::prelude;
@@ -29,6 +33,161 @@ namespace geode::utils::fetch {
     }
 }
 
+// A download into a file that can be picked up again after it fails. The
+// data goes into `<file>.part` and is only moved over the target once
+// complete, while `<file>.part.json` remembers the URL and the validator
+// (ETag or Last-Modified) the partial data was received with, so the next
+// attempt can ask for just the rest with a Range + If-Range request
+class PartialDownload final {
+private:
+    CURL* m_curl;
+    ghc::filesystem::path m_target;
+    ghc::filesystem::path m_partPath;
+    ghc::filesystem::path m_infoPath;
+    std::string m_url;
+    std::ofstream m_file;
+    uint64_t m_resumeFrom = 0;
+    std::string m_validator;
+    long m_code = 0;
+    bool m_started = false;
+    ByteVector m_errorBody;
+
+    static bool isHeader(std::string_view line, std::string_view name) {
+        return line.size() > name.size() && line[name.size()] == ':' &&
+            string::toLower(line.substr(0, name.size())) == name;
+    }
+
+public:
+    PartialDownload(CURL* curl, ghc::filesystem::path const& target, std::string const& url)
+      : m_curl(curl), m_target(target), m_url(url) {
+        m_partPath = target;
+        m_partPath += ".part";
+        m_infoPath = target;
+        m_infoPath += ".part.json";
+    }
+
+    // sets up the request to continue from earlier partial data, if any
+    void prepare(curl_slist*& headers) {
+        std::error_code ec;
+        auto size = ghc::filesystem::file_size(m_partPath, ec);
+        if (ec || !size) {
+            return;
+        }
+        auto info = file::readJson(m_infoPath);
+        if (
+            !info || !info.unwrap().is_object() ||
+            !info.unwrap().contains("url") || !info.unwrap()["url"].is_string() ||
+            !info.unwrap().contains("validator") || !info.unwrap()["validator"].is_string() ||
+            info.unwrap()["url"].as_string() != m_url
+        ) {
+            return;
+        }
+        m_resumeFrom = size;
+        auto range = fmt::format("{}-", size);
+        curl_easy_setopt(m_curl, CURLOPT_RANGE, range.c_str());
+        // if the file changed on the server, this gets us all of it instead
+        headers = curl_slist_append(
+            headers, fmt::format("If-Range: {}", info.unwrap()["validator"].as_string()).c_str()
+        );
+    }
+
+    // called for every response header line, including those of redirects
+    void header(std::string_view line) {
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+            line.remove_suffix(1);
+        }
+        if (line.starts_with("HTTP/")) {
+            m_validator.clear();
+        }
+        // weak etags can't be used with If-Range
+        else if (isHeader(line, "etag")) {
+            auto value = string::trim(line.substr(5));
+            m_validator = value.starts_with("W/") ? "" : value;
+        }
+        else if (isHeader(line, "last-modified") && m_validator.empty()) {
+            m_validator = string::trim(line.substr(14));
+        }
+    }
+
+    size_t write(char const* data, size_t size) {
+        if (!m_started) {
+            m_started = true;
+            curl_easy_getinfo(m_curl, CURLINFO_RESPONSE_CODE, &m_code);
+            if (m_code < 400) {
+                // the server sends the whole file again if it changed or 
+                // doesn't support ranges
+                if (m_code != 206) {
+                    m_resumeFrom = 0;
+                }
+                m_file.open(m_partPath, std::ios::out | std::ios::binary | (m_resumeFrom ? std::ios::app : std::ios::trunc));
+                if (!m_file.is_open()) {
+                    return 0;
+                }
+                std::error_code ec;
+                if (m_validator.empty()) {
+                    ghc::filesystem::remove(m_infoPath, ec);
+                }
+                else {
+                    (void)file::writeString(m_infoPath, matjson::Value(matjson::Object {
+                        { "url", m_url },
+                        { "validator", m_validator },
+                    }).dump(matjson::NO_INDENTATION));
+                }
+            }
+        }
+        // error pages don't belong in the file
+        if (m_code >= 400) {
+            m_errorBody.insert(m_errorBody.end(), data, data + size);
+            return size;
+        }
+        m_file.write(data, size);
+        return m_file ? size : 0;
+    }
+
+    std::ofstream* file() {
+        return &m_file;
+    }
+
+    // bytes already on disk from a previous attempt
+    uint64_t resumedBytes() const {
+        return m_started ? m_resumeFrom : 0;
+    }
+
+    ByteVector const& errorBody() const {
+        return m_errorBody;
+    }
+
+    Result<> finish() {
+        m_file.close();
+        std::error_code ec;
+        // nothing was written for an empty response
+        if (!m_started) {
+            std::ofstream(m_partPath, std::ios::out | std::ios::binary);
+        }
+        ghc::filesystem::rename(m_partPath, m_target, ec);
+        if (ec) {
+            return Err("Unable to move downloaded file into place: " + ec.message());
+        }
+        ghc::filesystem::remove(m_infoPath, ec);
+        return Ok();
+    }
+
+    // keeps the partial data around if it can be resumed later
+    void abandon(long code) {
+        m_file.close();
+        auto const wroteUnresumable = m_started && m_code < 400 && m_validator.empty();
+        if (wroteUnresumable || code == 416) {
+            std::error_code ec;
+            ghc::filesystem::remove(m_partPath, ec);
+            ghc::filesystem::remove(m_infoPath, ec);
+        }
+    }
+
+    static size_t writeCallback(char* data, size_t size, size_t nmemb, void* ptr) {
+        return static_cast<PartialDownload*>(ptr)->write(data, size * nmemb);
+    }
+};
+
 Result<> web::fetchFile(
     std::string const& url, ghc::filesystem::path const& into, FileProgressCallback prog
 ) {
@@ -147,7 +306,7 @@ private:
     };
     std::string m_id;
     std::string m_url;
-    std::vector<AsyncThen> m_thens;
+    std::vector<AsyncConvert> m_thens;
     std::vector<AsyncExpectCode> m_expects;
     std::vector<AsyncProgress> m_progresses;
     std::vector<AsyncCancelled> m_cancelleds;
@@ -160,6 +319,10 @@ private:
     std::condition_variable m_statusCV;
     std::mutex m_statusMutex;
     SentAsyncWebRequest* m_self;
+    // anything queued for the main thread holds a strong reference, as a
+    // newer request with the same id can replace this one in the registry
+    // before the queue runs
+    std::weak_ptr<SentAsyncWebRequest> m_handle;
 
     mutable std::mutex m_mutex;
     std::string m_userAgent;
@@ -180,6 +343,7 @@ private:
     void resume();
     void error(std::string const& error, int code);
     void doCancel();
+    void removeFromRunning();
 
 public:
     Impl(SentAsyncWebRequest* self, AsyncWebRequest const&, std::string const& id);
@@ -199,7 +363,7 @@ class AsyncWebRequest::Impl {
 public:
     std::optional<std::string> m_joinID;
     std::string m_url;
-    AsyncThen m_then = nullptr;
+    AsyncConvert m_then = nullptr;
     AsyncExpectCode m_expect = nullptr;
     AsyncProgress m_progress = nullptr;
     AsyncCancelled m_cancelled = nullptr;
@@ -216,8 +380,25 @@ public:
     SentAsyncWebRequestHandle send(AsyncWebRequest&);
 };
 
-static std::unordered_map<std::string, SentAsyncWebRequestHandle> RUNNING_REQUESTS{};
-static std::mutex RUNNING_REQUESTS_MUTEX;
+// requests that haven't finished yet, which also keeps them alive. split
+// into shards by id, so registering a request only ever contends with
+// requests that happen to hash to the same shard
+class RunningRequests final {
+public:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, SentAsyncWebRequestHandle> requests;
+    };
+
+    Shard& shardFor(std::string const& id) {
+        return m_shards[std::hash<std::string>()(id) % m_shards.size()];
+    }
+
+private:
+    std::array<Shard, 16> m_shards;
+};
+
+static RunningRequests RUNNING_REQUESTS;
 
 SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const& req, std::string const& id) :
     m_self(self),
@@ -254,6 +435,10 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
     std::thread([this, timeoutSeconds]() {
         AWAIT_RESUME();
 
+        // keep the request alive until its results have been delivered
+        auto self = m_handle.lock();
+        if (!self) return;
+
         auto curl = curl_easy_init();
         if (!curl) {
             return this->error("Curl not initialized", -1);
@@ -263,15 +448,25 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
         ByteVector ret;
         // output file if downloading to file. unique_ptr because not always
         // initialized but don't wanna manually managed memory
-        std::unique_ptr<std::ofstream> file = nullptr;
+        std::unique_ptr<PartialDownload> partial = nullptr;
+
+        // Headers
+        curl_slist* headers = nullptr;
+        for (auto& header : m_httpHeaders) {
+            headers = curl_slist_append(headers, header.c_str());
+        }
 
         // into file
         if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
-            file = std::make_unique<std::ofstream>(
-                std::get<ghc::filesystem::path>(m_target), std::ios::out | std::ios::binary
+            partial = std::make_unique<PartialDownload>(
+                curl, std::get<ghc::filesystem::path>(m_target), m_url
             );
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, file.get());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
+            // only plain downloads are safe to resume
+            if (!m_isPostRequest && (m_customRequest.empty() || m_customRequest == "GET")) {
+                partial->prepare(headers);
+            }
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, partial.get());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, PartialDownload::writeCallback);
         }
         // into stream
         else if (std::holds_alternative<std::ostream*>(m_target)) {
@@ -290,12 +485,6 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
         // User Agent
         curl_easy_setopt(curl, CURLOPT_USERAGENT, m_userAgent.c_str());
 
-        // Headers
-        curl_slist* headers = nullptr;
-        for (auto& header : m_httpHeaders) {
-            headers = curl_slist_append(headers, header.c_str());
-        }
-
         // Post request
         if (m_isPostRequest || m_customRequest.size()) {
             if (m_isPostRequest) {
@@ -328,16 +517,19 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
 
         struct ProgressData {
             SentAsyncWebRequest::Impl* self;
-            std::ofstream* file;
-        } data{this, file.get()};
+            PartialDownload* partial;
+        } data{this, partial.get()};
 
         curl_easy_setopt(curl, CURLOPT_HEADERDATA, &data);
         curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, +[](char* buffer, size_t size, size_t nitems, void* ptr){
             auto data = static_cast<ProgressData*>(ptr);
             std::string header;
             header.append(buffer, size * nitems); 
+            if (data->partial) {
+                data->partial->header(header);
+            }
             // send the header to the response header callback
-            Loader::get()->queueInMainThread([self = data->self, header]() {
+            Loader::get()->queueInMainThread([self = data->self, handle = data->self->m_handle.lock(), header]() {
                 std::unordered_map<std::string, std::string> headers;
                 std::string line;
                 std::stringstream ss(header);
@@ -363,17 +555,29 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
                     return !data->self->m_paused; 
                 });
                 if (data->self->m_cancelled) {
-                    if (data->file) {
-                        data->file->close();
+                    if (data->partial) {
+                        data->partial->file()->close();
                     }
                     return 1;
                 }
 
-                Loader::get()->queueInMainThread([self = data->self, now, total]() {
+                // count what was downloaded before resuming too
+                if (data->partial && data->partial->resumedBytes()) {
+                    now += data->partial->resumedBytes();
+                    if (total != 0.0) {
+                        total += data->partial->resumedBytes();
+                    }
+                }
+
+                auto handle = data->self->m_handle.lock();
+                if (!handle) {
+                    return 0;
+                }
+                Loader::get()->queueInMainThread([self = data->self, handle, now, total]() {
                     std::unique_lock<std::mutex> l(self->m_mutex);
                     for (auto& prog : self->m_progresses) {
                         l.unlock();
-                        prog(*self->m_self, now, total);
+                        prog(*handle, now, total);
                         l.lock();
                     }
                 });
@@ -384,8 +588,12 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
         auto res = curl_easy_perform(curl);
         long code = 0;
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+        curl_slist_free_all(headers);
         if (res != CURLE_OK) {
             curl_easy_cleanup(curl);
+            if (partial) {
+                partial->abandon(code);
+            }
             if (m_cancelled) {
                 return this->doCancel();
             } else {
@@ -393,49 +601,80 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
             }
         }
         if (code >= 400 && code < 600) {
+            if (partial) {
+                partial->abandon(code);
+                ret = partial->errorBody();
+            }
             std::string response_str(ret.begin(), ret.end());
             curl_easy_cleanup(curl);
             return this->error(response_str, code);
         }
         curl_easy_cleanup(curl);
 
-        AWAIT_RESUME();
+        if (partial) {
+            auto finished = partial->finish();
+            if (!finished) {
+                return this->error(finished.unwrapErr(), code);
+            }
+        }
 
-        // if something is still holding a handle to this
-        // request, then they may still cancel it
-        m_finished = true;
+        AWAIT_RESUME();
 
-        Loader::get()->queueInMainThread([this, ret]() {
+        // convert the response here so the GD thread only gets the results.
+        // thens can still be joined in until the request is finished
+        std::vector<AsyncDeliver> delivers;
+        {
             std::unique_lock<std::mutex> l(m_mutex);
-            for (auto& then : m_thens) {
+            for (size_t i = 0; i < m_thens.size(); i++) {
+                auto then = m_thens[i];
                 l.unlock();
-                then(*m_self, ret);
+                delivers.push_back(then(ret));
                 l.lock();
             }
-            std::lock_guard __(RUNNING_REQUESTS_MUTEX);
-            RUNNING_REQUESTS.erase(m_id);
+            // if something is still holding a handle to this
+            // request, then they may still cancel it
+            m_finished = true;
+        }
+        ret = ByteVector();
+
+        Loader::get()->queueInMainThread([this, self, delivers = std::move(delivers)]() {
+            // cancelled after finishing, in which case cancel()
+            // has already cleaned up and the results are dropped
+            if (!m_cancelled) {
+                for (auto& deliver : delivers) {
+                    deliver(*self);
+                }
+            }
+            this->removeFromRunning();
         });
     }).detach();
 }
 
+void SentAsyncWebRequest::Impl::removeFromRunning() {
+    // a finished request's id may have been reused by a newer one already
+    auto& shard = RUNNING_REQUESTS.shardFor(m_id);
+    std::lock_guard _(shard.mutex);
+    auto it = shard.requests.find(m_id);
+    if (it != shard.requests.end() && it->second->m_impl.get() == this) {
+        shard.requests.erase(it);
+    }
+}
+
 void SentAsyncWebRequest::Impl::doCancel() {
     if (m_cleanedUp) return;
     m_cleanedUp = true;
 
-    // remove file if downloaded to one
-    if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
-        auto path = std::get<ghc::filesystem::path>(m_target);
-        if (ghc::filesystem::exists(path)) {
-            std::error_code ec;
-            ghc::filesystem::remove(path, ec);
-        }
-    }
+    // file downloads only write to the target once they're complete, so it
+    // may still be the previous file and is left alone. partial data that
+    // can't be resumed has already been removed by PartialDownload::abandon
 
-    Loader::get()->queueInMainThread([this]() {
+    auto self = m_handle.lock();
+    if (!self) return;
+    Loader::get()->queueInMainThread([this, self]() {
         std::unique_lock<std::mutex> l(m_mutex);
         for (auto& canc : m_cancelleds) {
             l.unlock();
-            canc(*m_self);
+            canc(*self);
             l.lock();
         }
     });
@@ -468,7 +707,9 @@ void SentAsyncWebRequest::Impl::error(std::string const& error, int code) {
     m_statusCV.wait(lock, [this]() { 
         return !m_paused; 
     });
-    Loader::get()->queueInMainThread([this, error, code]() {
+    auto self = m_handle.lock();
+    if (!self) return;
+    Loader::get()->queueInMainThread([this, self, error, code]() {
         {
             std::unique_lock<std::mutex> l(m_mutex);
             for (auto& expect : m_expects) {
@@ -477,8 +718,7 @@ void SentAsyncWebRequest::Impl::error(std::string const& error, int code) {
                 l.lock();
             }
         }
-        std::lock_guard _(RUNNING_REQUESTS_MUTEX);
-        RUNNING_REQUESTS.erase(m_id);
+        this->removeFromRunning();
     });
 }
 
@@ -488,6 +728,7 @@ SentAsyncWebRequest::~SentAsyncWebRequest() {}
 std::shared_ptr<SentAsyncWebRequest> SentAsyncWebRequest::create(AsyncWebRequest const& request, std::string const& id) {
     auto ret = std::make_shared<SentAsyncWebRequest>();
     ret->m_impl = std::move(std::make_shared<SentAsyncWebRequest::Impl>(ret.get(), request, id));
+    ret->m_impl->m_handle = ret;
     return ret;
 }
 std::string SentAsyncWebRequest::getResponseHeader(std::string_view header) const {
@@ -527,7 +768,18 @@ AsyncWebRequest::~AsyncWebRequest() {
 }
 
 AsyncWebRequest& AsyncWebRequest::setThen(AsyncThen then) {
-    m_impl->m_then = then;
+    // kept for mods built against the old header, these get the raw bytes on
+    // the GD thread like before
+    return this->setConvert([then](ByteVector const& data) -> AsyncDeliver {
+        auto bytes = std::make_shared<ByteVector>(data);
+        return [then, bytes](SentAsyncWebRequest& req) {
+            then(req, *bytes);
+        };
+    });
+}
+
+AsyncWebRequest& AsyncWebRequest::setConvert(AsyncConvert convert) {
+    m_impl->m_then = convert;
     return *this;
 }
 
@@ -634,36 +886,36 @@ SentAsyncWebRequestHandle AsyncWebRequest::Impl::send(AsyncWebRequest& reqObj) {
     if (m_sent) return nullptr;
     m_sent = true;
 
-    std::lock_guard __(RUNNING_REQUESTS_MUTEX);
-
-    // pause all running requests
-    for (auto& [_, req] : RUNNING_REQUESTS) {
-        req->pause();
-    }
-
-    SentAsyncWebRequestHandle ret;
-
-    static size_t COUNTER = 0;
-    if (m_joinID && RUNNING_REQUESTS.count(m_joinID.value())) {
-        auto& req = RUNNING_REQUESTS.at(m_joinID.value());
-        std::lock_guard _(req->m_impl->m_mutex);
-        if (m_then) req->m_impl->m_thens.push_back(m_then);
-        if (m_progress) req->m_impl->m_progresses.push_back(m_progress);
-        if (m_expect) req->m_impl->m_expects.push_back(m_expect);
-        if (m_cancelled) req->m_impl->m_cancelleds.push_back(m_cancelled);
-        ret = req;
-    }
-    else {
-        auto id = m_joinID.value_or("__anon_request_" + std::to_string(COUNTER++));
-        ret = SentAsyncWebRequest::create(reqObj, id);
-        RUNNING_REQUESTS.insert({id, ret});
+    static std::atomic_size_t COUNTER = 0;
+    auto id = m_joinID.value_or("__anon_request_" + std::to_string(COUNTER++));
+
+    auto& shard = RUNNING_REQUESTS.shardFor(id);
+    std::unique_lock lock(shard.mutex);
+
+    if (m_joinID) {
+        auto it = shard.requests.find(id);
+        if (it != shard.requests.end()) {
+            auto req = it->second;
+            // the request's own mutex is enough to keep it from finishing
+            // while we join, and once the response has been converted
+            // it's too late to join
+            std::lock_guard _(req->m_impl->m_mutex);
+            if (!req->m_impl->m_finished) {
+                if (m_then) req->m_impl->m_thens.push_back(m_then);
+                if (m_progress) req->m_impl->m_progresses.push_back(m_progress);
+                if (m_expect) req->m_impl->m_expects.push_back(m_expect);
+                if (m_cancelled) req->m_impl->m_cancelleds.push_back(m_cancelled);
+                return req;
+            }
+        }
     }
 
-    // resume all running requests
-    for (auto& [_, req] : RUNNING_REQUESTS) {
-        req->resume();
-    }
+    auto ret = SentAsyncWebRequest::create(reqObj, id);
+    shard.requests.insert_or_assign(id, ret);
+    lock.unlock();
 
+    // requests start out paused so they're registered before doing anything
+    ret->resume();
     return ret;
 }
 
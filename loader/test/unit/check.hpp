@@ -0,0 +1,24 @@
+#pragma once
+
+#include <iostream>
+
+// The unit tests are plain executables run by ctest, a failed check is 
+// reported and makes the test return a non-zero exit code
+
+inline int g_failedChecks = 0;
+
+#define CHECK(...) do {                                                 \
+        if (!(__VA_ARGS__)) {                                           \
+            std::cerr << __FILE__ << ":" << __LINE__                    \
+                << ": check failed: " #__VA_ARGS__ << std::endl;        \
+            g_failedChecks += 1;                                        \
+        }                                                               \
+    } while (false)
+
+inline int checkResult() {
+    if (g_failedChecks) {
+        std::cerr << g_failedChecks << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
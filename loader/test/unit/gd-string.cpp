@@ -0,0 +1,310 @@
+#include "check.hpp"
+
+#include <Geode/c++stl/gdstdlib.hpp>
+#include "../../src/c++stl/string-impl.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <new>
+
+using geode::stl::StringData;
+using geode::stl::StringImpl;
+using namespace std::string_view_literals;
+
+// Built once per StringImpl layout, with the loader's string.cpp and the
+// platform's gdstdlib.cpp. Every allocation the string makes goes through
+// the stubs below, so the tests can check that moves don't copy and that
+// nothing is leaked
+
+// a fixed size set, as the replaced operator new can't allocate itself
+struct LiveBlocks {
+    std::array<void*, 1024> blocks;
+    size_t count = 0;
+
+    void* const* end() const {
+        return blocks.data() + count;
+    }
+    bool contains(void* ptr) const {
+        return std::find(blocks.data(), this->end(), ptr) != this->end();
+    }
+    void insert(void* ptr) {
+        if (count == blocks.size()) {
+            std::abort();
+        }
+        blocks[count++] = ptr;
+    }
+    void erase(void* ptr) {
+        auto it = std::find(blocks.begin(), blocks.begin() + count, ptr);
+        *it = blocks[--count];
+    }
+    size_t size() const {
+        return count;
+    }
+};
+
+static size_t g_allocations = 0;
+static LiveBlocks g_live;
+
+static void* stubNew(size_t size) {
+    auto ptr = std::malloc(size);
+    g_allocations += 1;
+    g_live.insert(ptr);
+    return ptr;
+}
+
+static void stubDelete(void* ptr) {
+    CHECK(g_live.contains(ptr));
+    g_live.erase(ptr);
+    std::free(ptr);
+}
+
+#if defined(GEODE_IS_ANDROID)
+// stands in for the game's operator new and delete, which gnustl's
+// refcounted strings are allocated with
+void* gd::operatorNew(size_t size) {
+    return stubNew(size);
+}
+void gd::operatorDelete(void* ptr) {
+    stubDelete(ptr);
+}
+#else
+// msvc's strings use the global operator new, only count the allocations
+// made while a test is looking
+static bool g_tracking = false;
+
+void* operator new(size_t size) {
+    if (g_tracking) {
+        return stubNew(size);
+    }
+    if (auto ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept {
+    if (g_live.contains(ptr)) {
+        stubDelete(ptr);
+    }
+    else {
+        std::free(ptr);
+    }
+}
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+#endif
+
+// Allocations made and blocks still alive since it was created
+struct AllocationScope {
+    size_t allocations = g_allocations;
+    size_t live = g_live.size();
+
+    AllocationScope() {
+    #if !defined(GEODE_IS_ANDROID)
+        g_tracking = true;
+    #endif
+    }
+    ~AllocationScope() {
+    #if !defined(GEODE_IS_ANDROID)
+        g_tracking = false;
+    #endif
+    }
+
+    size_t made() const {
+        return g_allocations - allocations;
+    }
+    size_t leaked() const {
+        return g_live.size() - live;
+    }
+};
+
+// long enough to never fit in msvc's small storage
+static constexpr std::string_view LONG_TEXT = "the quick brown fox jumps over the lazy dog";
+
+static void testMove() {
+    // make sure the empty rep is already set up
+    gd::string warmup;
+
+    AllocationScope scope;
+    {
+        gd::string a(LONG_TEXT);
+        CHECK(scope.made() == 1);
+        auto storage = a.data();
+
+        gd::string b(std::move(a));
+        CHECK(scope.made() == 1);
+        CHECK(b.data() == storage);
+        CHECK(b == LONG_TEXT);
+        CHECK(a.empty());
+        CHECK(a.c_str()[0] == 0);
+
+        gd::string c(LONG_TEXT.substr(4));
+        CHECK(scope.made() == 2);
+        c = std::move(b);
+        // c's old storage is freed, b's is taken over
+        CHECK(scope.made() == 2);
+        CHECK(scope.leaked() == 1);
+        CHECK(c.data() == storage);
+        CHECK(b.empty());
+
+        auto& self = c;
+        c = std::move(self);
+        CHECK(c == LONG_TEXT);
+
+        // moved-from strings are still usable
+        a = "reused";
+        CHECK(a == "reused"sv);
+    }
+    CHECK(scope.leaked() == 0);
+}
+
+static void testViewConstruction() {
+    gd::string warmup;
+
+    AllocationScope scope;
+    {
+        // straight from the view, without a std::string in between
+        gd::string fromView(LONG_TEXT.substr(4, 31));
+        CHECK(scope.made() == 1);
+        CHECK(fromView == "quick brown fox jumps over the "sv);
+        CHECK(fromView.size() == 31);
+        CHECK(fromView.c_str()[31] == 0);
+
+        gd::string empty(std::string_view {});
+        CHECK(empty.empty());
+
+        // assigning a part of itself
+        fromView = std::string_view(fromView).substr(6, 5);
+        CHECK(fromView == "brown"sv);
+    }
+    CHECK(scope.leaked() == 0);
+}
+
+static void testReserve() {
+    gd::string warmup;
+
+    AllocationScope scope;
+    {
+        gd::string str("abc");
+        str.reserve(100);
+        CHECK(str.capacity() >= 100);
+        CHECK(str == "abc"sv);
+        CHECK(str.c_str()[3] == 0);
+
+        auto made = scope.made();
+        for (size_t i = 3; i < 100; i++) {
+            str.append("x");
+        }
+        CHECK(scope.made() == made);
+        CHECK(str.size() == 100);
+
+        // reserving less than the size never shrinks
+        str.reserve(10);
+        CHECK(str.size() == 100);
+        CHECK(str.capacity() >= 100);
+
+        gd::string empty;
+        empty.reserve(0);
+        CHECK(empty.empty());
+    }
+    CHECK(scope.leaked() == 0);
+}
+
+static void testAppend() {
+    gd::string warmup;
+
+    AllocationScope scope;
+    {
+        gd::string str;
+        std::string expected;
+        for (size_t i = 0; i < 1000; i++) {
+            auto c = std::string(1, static_cast<char>('a' + i % 26));
+            str.append(c);
+            expected += c;
+        }
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[1000] == 0);
+        // the capacity grows geometrically
+        CHECK(scope.made() < 20);
+
+        str += "";
+        CHECK(str.size() == 1000);
+
+        // appending a part of itself, which may have to reallocate first
+        gd::string self(LONG_TEXT);
+        self.append(self);
+        CHECK(std::string_view(self) == std::string(LONG_TEXT) + std::string(LONG_TEXT));
+        self.append(std::string_view(self).substr(4, 5));
+        CHECK(std::string_view(self) == std::string(LONG_TEXT) + std::string(LONG_TEXT) + "quick");
+    }
+    CHECK(scope.leaked() == 0);
+}
+
+#if defined(GEODE_IS_ANDROID)
+static StringData& dataOf(gd::string& str) {
+    // gd::string is nothing but its StringData
+    return *reinterpret_cast<StringData*>(&str);
+}
+
+static void testRefcounted() {
+    gd::string warmup;
+
+    AllocationScope scope;
+    {
+        gd::string str(LONG_TEXT);
+        auto& data = dataOf(str);
+        auto* internal = data.m_data;
+
+        // free drops our reference and forgets the pointer, so doing it
+        // twice can't touch someone else's refcount
+        internal[-1].m_refcount = 1;
+        StringImpl{data}.free();
+        CHECK(data.m_data == nullptr);
+        CHECK(internal[-1].m_refcount == 0);
+        StringImpl{data}.free();
+        CHECK(internal[-1].m_refcount == 0);
+        CHECK(scope.leaked() == 1);
+
+        // the last reference actually frees it
+        data.m_data = internal;
+        StringImpl{data}.free();
+        CHECK(data.m_data == nullptr);
+        CHECK(scope.leaked() == 0);
+        StringImpl{data}.setEmpty();
+        CHECK(str.empty());
+
+        // moves keep sharing the rep without touching the refcount
+        str = LONG_TEXT;
+        internal = dataOf(str).m_data;
+        internal[-1].m_refcount = 1;
+        gd::string moved(std::move(str));
+        CHECK(dataOf(moved).m_data == internal);
+        CHECK(internal[-1].m_refcount == 1);
+
+        // writing to a shared rep copies it first
+        auto made = scope.made();
+        moved.append("!");
+        CHECK(scope.made() == made + 1);
+        CHECK(dataOf(moved).m_data != internal);
+        CHECK(internal[-1].m_refcount == 0);
+        CHECK(std::string_view(reinterpret_cast<char*>(internal)) == LONG_TEXT);
+        CHECK(std::string_view(moved) == std::string(LONG_TEXT) + "!");
+
+        // drop the reference the game would have held
+        gd::operatorDelete(&internal[-1]);
+    }
+    CHECK(scope.leaked() == 0);
+}
+#endif
+
+int main() {
+    testMove();
+    testViewConstruction();
+    testReserve();
+    testAppend();
+#if defined(GEODE_IS_ANDROID)
+    testRefcounted();
+#endif
+    return checkResult();
+}
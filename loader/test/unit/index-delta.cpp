@@ -0,0 +1,204 @@
+#include "check.hpp"
+
+#include <IndexDelta.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+
+using namespace geode::index_delta;
+
+// The two snapshots of the index in fixtures/index differ by a new version
+// (test.alpha), a changed about.md (test.beta), a changed entry.json
+// (test.gamma 1.1.0), a removed mod (test.delta) and config.json listing all
+// of that. Patching the old snapshot with its delta and only re-parsing the
+// touched entries has to give the same items as parsing the new one fully
+
+static auto const FIXTURES = std::filesystem::path(GEODE_TEST_FIXTURES) / "index";
+
+// relative path -> contents
+using Tree = std::map<std::string, std::string>;
+
+static Tree readTree(std::filesystem::path const& root) {
+    Tree tree;
+    for (auto& file : std::filesystem::recursive_directory_iterator(root)) {
+        if (!file.is_regular_file()) {
+            continue;
+        }
+        std::ifstream stream(file.path(), std::ios::binary);
+        std::stringstream data;
+        data << stream.rdbuf();
+        tree[std::filesystem::relative(file.path(), root).generic_string()] = data.str();
+    }
+    return tree;
+}
+
+// What github's compare API reports between the two snapshots; the url is
+// just the path in the new snapshot
+static std::vector<IndexChange> diffTrees(Tree const& before, Tree const& after) {
+    std::vector<IndexChange> changes;
+    for (auto& [path, data] : after) {
+        auto old = before.find(path);
+        if (old == before.end() || old->second != data) {
+            changes.push_back({ .path = path, .url = path });
+        }
+    }
+    for (auto& [path, _] : before) {
+        if (!after.count(path)) {
+            changes.push_back({ .path = path, .removed = true });
+        }
+    }
+    return changes;
+}
+
+// Same as Index::Impl::applyIndexChanges
+static void applyChanges(Tree& tree, std::vector<IndexChange> const& changes, Tree const& source) {
+    for (auto& change : changes) {
+        if (!change.previousPath.empty()) {
+            tree.erase(change.previousPath);
+        }
+        if (change.removed) {
+            tree.erase(change.path);
+        }
+        else {
+            tree[change.path] = source.at(change.url);
+        }
+    }
+}
+
+// Stands in for IndexItem, which is made from the files in the version's
+// directory plus the special files (about.md etc.) in the mod's directory
+using Item = std::shared_ptr<std::string const>;
+using Items = std::map<std::pair<std::string, std::string>, Item>;
+
+static Item parseItem(Tree const& tree, std::string const& modID, std::string const& version) {
+    auto rootDir = "mods-v2/" + modID + "/";
+    std::string data;
+    for (auto& [path, contents] : tree) {
+        if (!path.starts_with(rootDir)) {
+            continue;
+        }
+        auto rest = path.substr(rootDir.size());
+        if (rest.find('/') == std::string::npos || rest.starts_with(version + "/")) {
+            data += path + "\n" + contents;
+        }
+    }
+    return std::make_shared<std::string const>(data);
+}
+
+// Same as Index::Impl::updateFromLocalTree
+static Items updateItems(Tree const& tree, TouchedEntries const& touched, Items const& previous) {
+    std::set<std::pair<std::string, std::string>> versions;
+    for (auto& [path, _] : tree) {
+        auto rootDir = path.find('/');
+        auto versionDir = path.find('/', rootDir + 1);
+        auto fileName = path.find('/', versionDir + 1);
+        if (path.starts_with("mods-v2/") && fileName != std::string::npos) {
+            versions.insert({
+                path.substr(rootDir + 1, versionDir - rootDir - 1),
+                path.substr(versionDir + 1, fileName - versionDir - 1)
+            });
+        }
+    }
+    Items items;
+    for (auto& [modID, version] : versions) {
+        auto old = previous.find({ modID, version });
+        if (isEntryReusable(touched, modID, version) && old != previous.end()) {
+            items[{ modID, version }] = old->second;
+        }
+        else {
+            items[{ modID, version }] = parseItem(tree, modID, version);
+        }
+    }
+    return items;
+}
+
+static bool sameItems(Items const& a, Items const& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (auto& [key, item] : a) {
+        if (!b.count(key) || *b.at(key) != *item) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void testTouchedIndexEntry() {
+    CHECK(touchedIndexEntry("mods-v2/test.alpha/about.md") == "test.alpha");
+    CHECK(touchedIndexEntry("mods-v2/test.alpha/1.0.0/mod.json") == "test.alpha/1.0.0");
+    CHECK(touchedIndexEntry("mods-v2/test.alpha/1.0.0/logo/logo.png") == "test.alpha/1.0.0");
+    CHECK(!touchedIndexEntry("config.json"));
+    CHECK(!touchedIndexEntry("mods-v2/README.md"));
+    CHECK(!touchedIndexEntry("mods/test.alpha/1.0.0/mod.json"));
+}
+
+static void testTouchedIndexEntries() {
+    std::vector<IndexChange> renamed = {
+        { .path = "mods-v2/test.alpha/1.1.0/mod.json", .previousPath = "mods-v2/test.alpha/1.0.0/mod.json" },
+        { .path = "mods-v2/test.beta/about.md", .removed = true },
+    };
+    CHECK(touchedIndexEntries(renamed) == std::unordered_set<std::string> {
+        "test.alpha/1.0.0", "test.alpha/1.1.0", "test.beta"
+    });
+
+    // anything outside of mods-v2/<id>/ rebuilds the whole index
+    std::vector<IndexChange> config = {
+        { .path = "mods-v2/test.alpha/about.md" },
+        { .path = "config.json" },
+    };
+    CHECK(!touchedIndexEntries(config));
+    std::vector<IndexChange> movedOut = {
+        { .path = "mods-v2/test.alpha/about.md", .previousPath = "README.md" },
+    };
+    CHECK(!touchedIndexEntries(movedOut));
+
+    CHECK(!isEntryReusable(std::nullopt, "test.alpha", "1.0.0"));
+    CHECK(isEntryReusable(std::unordered_set<std::string> { "test.beta" }, "test.alpha", "1.0.0"));
+    CHECK(!isEntryReusable(std::unordered_set<std::string> { "test.alpha" }, "test.alpha", "1.0.0"));
+    CHECK(!isEntryReusable(std::unordered_set<std::string> { "test.alpha/1.0.0" }, "test.alpha", "1.0.0"));
+}
+
+static void testSnapshots() {
+    auto before = readTree(FIXTURES / "before");
+    auto after = readTree(FIXTURES / "after");
+    auto previous = updateItems(before, std::nullopt, {});
+    auto full = updateItems(after, std::nullopt, {});
+
+    auto changes = diffTrees(before, after);
+    auto patched = before;
+    applyChanges(patched, changes, after);
+    CHECK(patched == after);
+
+    // config.json is part of the delta, so nothing gets reused
+    auto touched = touchedIndexEntries(changes);
+    CHECK(!touched);
+    CHECK(sameItems(updateItems(patched, touched, previous), full));
+
+    // without it only the changed entries get re-parsed
+    std::erase_if(changes, [](auto const& change) { return change.path == "config.json"; });
+    touched = touchedIndexEntries(changes);
+    CHECK(touched == std::unordered_set<std::string> {
+        "test.alpha/1.1.0", "test.beta", "test.gamma/1.1.0", "test.delta/1.0.0"
+    });
+    auto delta = updateItems(patched, touched, previous);
+    CHECK(sameItems(delta, full));
+    CHECK(delta.at({ "test.epsilon", "1.0.0" }) == previous.at({ "test.epsilon", "1.0.0" }));
+    CHECK(delta.at({ "test.gamma", "1.0.0" }) == previous.at({ "test.gamma", "1.0.0" }));
+    CHECK(delta.at({ "test.beta", "1.0.0" }) != previous.at({ "test.beta", "1.0.0" }));
+
+    // and missing one of them would leave a stale item behind
+    touched->erase("test.beta");
+    CHECK(!sameItems(updateItems(patched, touched, previous), full));
+}
+
+int main() {
+    testTouchedIndexEntry();
+    testTouchedIndexEntries();
+    testSnapshots();
+    return checkResult();
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+// Stands in for the real platform header when building parts of the loader 
+// on the host. The platform whose layout is being tested is picked by the 
+// test target (GEODE_IS_ANDROID, GEODE_IS_WINDOWS, ...)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#define GEODE_DLL
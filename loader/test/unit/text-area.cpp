@@ -0,0 +1,306 @@
+#include "check.hpp"
+
+#include <TextAreaLayout.hpp>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+
+using namespace geode::text_area;
+
+// SimpleTextArea used to lay its text out by appending characters to
+// CCLabelBMFont labels, which recompute their whole size on every change.
+// That algorithm is ported below with the labels reduced to their strings
+// and sizes, and the one-pass layout has to break every text exactly the same
+// way for the font in fixtures/text-area
+
+static auto const FIXTURES = std::filesystem::path(GEODE_TEST_FIXTURES) / "text-area";
+
+// The parts of CCBMFontConfiguration the layout uses, read from a text .fnt
+struct TestFont {
+    int commonHeight = 0;
+    std::map<unsigned short, Glyph> glyphs;
+    std::map<unsigned int, int> kernings;
+
+    static TestFont load(std::filesystem::path const& path) {
+        TestFont font;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream stream(line);
+            std::string tag;
+            stream >> tag;
+
+            std::map<std::string, std::string> values;
+            std::string pair;
+            while (stream >> pair) {
+                auto eq = pair.find('=');
+                if (eq != std::string::npos) {
+                    values[pair.substr(0, eq)] = pair.substr(eq + 1);
+                }
+            }
+
+            if (tag == "common") {
+                font.commonHeight = std::stoi(values.at("lineHeight"));
+            }
+            else if (tag == "char") {
+                font.glyphs[std::stoi(values.at("id"))] = {
+                    std::stoi(values.at("xadvance")), std::stof(values.at("width"))
+                };
+            }
+            else if (tag == "kerning") {
+                auto first = static_cast<unsigned int>(std::stoi(values.at("first")));
+                auto second = static_cast<unsigned int>(std::stoi(values.at("second")));
+                font.kernings[(first << 16) | (second & 0xffff)] = std::stoi(values.at("amount"));
+            }
+        }
+        return font;
+    }
+
+    std::optional<Glyph> glyph(unsigned short c) const {
+        auto it = glyphs.find(c);
+        if (it == glyphs.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    int kerning(unsigned short first, unsigned short second) const {
+        auto it = kernings.find((static_cast<unsigned int>(first) << 16) | (second & 0xffff));
+        return it == kernings.end() ? 0 : it->second;
+    }
+};
+
+struct Layout {
+    TestFont const& font;
+    float scaleFactor;
+    WrapOptions options;
+    float linePadding;
+
+    float calculateOffset(std::string const& line) const {
+        // empty labels have no size
+        if (line.empty()) {
+            return linePadding;
+        }
+        return linePadding + font.commonHeight / scaleFactor * options.scale;
+    }
+};
+
+// CCLabelBMFont::createFontChars, the content width of a label of this text
+static float labelWidth(TestFont const& font, float scaleFactor, std::string const& text) {
+    int nextFontPositionX = 0;
+    int longestLine = 0;
+    unsigned short prev = -1;
+    std::optional<Glyph> fontDef;
+    for (char ch : text) {
+        unsigned short c = static_cast<unsigned char>(ch);
+        auto glyph = font.glyph(c);
+        if (!glyph) {
+            continue;
+        }
+        int kerningAmount = font.kerning(prev, c);
+        fontDef = glyph;
+        nextFontPositionX += fontDef->xAdvance + kerningAmount;
+        prev = c;
+        if (longestLine < nextFontPositionX) {
+            longestLine = nextFontPositionX;
+        }
+    }
+    if (!fontDef) {
+        return 0;
+    }
+    float width = longestLine;
+    if (fontDef->xAdvance < fontDef->width) {
+        width = longestLine + fontDef->width - fontDef->xAdvance;
+    }
+    return width / scaleFactor;
+}
+
+// The old SimpleTextArea::charIteration. Two bugs in the old overflow
+// handlers are fixed the same way as in TextAreaLayout.hpp: word wrap built
+// the next line with std::string's arguments swapped, and cutoff wrap read
+// before the start of one character lines
+static WrappedLines oldCharIteration(Layout const& layout, std::string const& text, bool cutoff) {
+    float top = 0;
+    std::vector<std::string> lines = { "" };
+    std::vector<float> tops = { top };
+
+    auto overflow = [&](std::string& line, char c) -> std::string {
+        if (!cutoff) {
+            static std::string delimiters(" `~!@#$%^&*()-_=+[{}];:'\",<.>/?\\|");
+
+            if (delimiters.find(c) == std::string_view::npos) {
+                const std::string text = line;
+                const size_t position = text.find_last_of(delimiters) + 1;
+
+                line = text.substr(0, position);
+
+                return text.substr(position) + c;
+            } else {
+                return std::string(c != ' ', c);
+            }
+        }
+        const std::string text = line;
+        const char back = text.back();
+        const bool lastIsSpace = back == ' ';
+        std::string newLine = std::string(!lastIsSpace, back).append(std::string(c != ' ', c));
+
+        if (!lastIsSpace) {
+            if (text.size() > 1 && text[text.size() - 2] == ' ') {
+                line = text.substr(0, text.size() - 1);
+            } else {
+                line = text.substr(0, text.size() - 1) + '-';
+            }
+        }
+
+        return newLine;
+    };
+
+    auto& options = layout.options;
+    for (const char c : text) {
+        if (options.maxLines && lines.size() > options.maxLines) {
+            std::string& last = lines.at(options.maxLines - 1);
+            const std::string text = last;
+
+            lines.pop_back();
+            tops.pop_back();
+            lines.at(options.maxLines - 1) = text.substr(0, text.size() - 3).append("...");
+
+            break;
+        } else if (c == '\n') {
+            tops.push_back(top -= layout.calculateOffset(lines.back()));
+            lines.push_back("");
+        } else if (
+            options.artificialWidth &&
+            labelWidth(layout.font, layout.scaleFactor, lines.back()) * options.scale >= options.width
+        ) {
+            tops.push_back(top -= layout.calculateOffset(lines.back()));
+            auto next = overflow(lines.back(), c);
+            lines.push_back(next);
+        } else {
+            lines.back() = lines.back() + c;
+        }
+    }
+    return { lines, tops };
+}
+
+static WrappedLines newCharIteration(Layout const& layout, std::string const& text, bool cutoff) {
+    return wrapLines(
+        text, LineMeasure(layout.font, layout.scaleFactor), layout.options,
+        [&](std::string const& line) { return layout.calculateOffset(line); },
+        cutoff ? &cutoffWrapOverflow : &wordWrapOverflow
+    );
+}
+
+static bool sameLayout(WrappedLines const& a, WrappedLines const& b) {
+    return a.lines == b.lines && a.tops == b.tops;
+}
+
+static void testMeasure(TestFont const& font) {
+    LineMeasure measure(font, 1.f);
+    for (auto text : {
+        "", " ", "AVAVA", "LTLT", "ffff", "Wavy jiffy/", "~`~", "a~b`c", "The quick brown fox"
+    }) {
+        measure.assign(text);
+        CHECK(measure.width() == labelWidth(font, 1.f, text));
+    }
+    LineMeasure halved(font, 2.f);
+    halved.assign("Typography");
+    CHECK(halved.width() == labelWidth(font, 2.f, "Typography"));
+}
+
+static void testGolden(TestFont const& font) {
+    Layout layout { font, 1.f, { .artificialWidth = true, .width = 200 }, 0 };
+    auto text = "The quick brown fox jumps over the lazy dog, twice!";
+
+    auto words = newCharIteration(layout, text, false);
+    CHECK(sameLayout(words, oldCharIteration(layout, text, false)));
+    CHECK(words.lines == std::vector<std::string> {
+        "The quick ", "brown fox ", "jumps over the", "lazy dog, twice!"
+    });
+    CHECK(words.tops == std::vector<float> { 0, -36, -72, -108 });
+
+    auto cutoff = newCharIteration(layout, text, true);
+    CHECK(sameLayout(cutoff, oldCharIteration(layout, text, true)));
+    CHECK(cutoff.lines == std::vector<std::string> {
+        "The quick bro-", "wn fox jumps ", "over the lazy ", "dog, twice!"
+    });
+
+    layout.options.maxLines = 2;
+    auto limited = newCharIteration(layout, text, false);
+    CHECK(sameLayout(limited, oldCharIteration(layout, text, false)));
+    CHECK(limited.lines == std::vector<std::string> { "The quick ", "brown f..." });
+
+    // unless the width was set, only newlines break lines
+    layout.options = {};
+    layout.linePadding = 4;
+    auto unwrapped = newCharIteration(layout, "first\n\nthird", false);
+    CHECK(sameLayout(unwrapped, oldCharIteration(layout, "first\n\nthird", false)));
+    CHECK(unwrapped.lines == std::vector<std::string> { "first", "", "third" });
+    CHECK(unwrapped.tops == std::vector<float> { 0, -40, -44 });
+}
+
+static void testRandomTexts(TestFont const& font) {
+    std::mt19937 rng(70);
+    auto pick = [&](auto const& options) {
+        return options[std::uniform_int_distribution<size_t>(0, std::size(options) - 1)(rng)];
+    };
+    auto number = [&](int min, int max) {
+        return std::uniform_int_distribution<int>(min, max)(rng);
+    };
+
+    std::string letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    std::string punctuation = ".,;:!?-_'\"()[]/\\|@#$%^&*+=<>{}~`";
+    size_t compared = 0;
+
+    for (size_t i = 0; i < 1500; i++) {
+        std::string text;
+        auto words = number(0, 40);
+        for (int w = 0; w < words; w++) {
+            // some words are too long for any line
+            auto length = number(0, 100) < 5 ? number(20, 60) : number(1, 10);
+            for (int l = 0; l < length; l++) {
+                text += number(0, 10) ? letters[number(0, letters.size() - 1)] : punctuation[number(0, punctuation.size() - 1)];
+            }
+            text += pick(std::array<char const*, 6> { " ", " ", " ", "  ", "\n", "-" });
+        }
+
+        Layout layout {
+            font,
+            pick(std::array { 1.f, 2.f }),
+            {
+                .maxLines = static_cast<size_t>(pick(std::array { 0, 0, 1, 3 })),
+                .artificialWidth = number(0, 9) != 0,
+                .width = static_cast<float>(number(10, 400)),
+                .scale = pick(std::array { .5f, .7f, 1.f, 1.3f }),
+            },
+            pick(std::array { 0.f, 2.5f }),
+        };
+        for (bool cutoff : { false, true }) {
+            auto old = oldCharIteration(layout, text, cutoff);
+            auto now = newCharIteration(layout, text, cutoff);
+            if (!sameLayout(old, now)) {
+                std::cerr << "layouts differ (" << (cutoff ? "cutoff" : "word") << " wrap, width "
+                    << layout.options.width << ") for:\n" << text << std::endl;
+            }
+            CHECK(sameLayout(old, now));
+            compared += 1;
+        }
+    }
+    CHECK(compared == 3000);
+}
+
+int main() {
+    auto font = TestFont::load(FIXTURES / "test.fnt");
+    CHECK(font.commonHeight == 36);
+    CHECK(font.glyphs.size() == 93);
+    CHECK(font.kernings.size() == 10);
+
+    testMeasure(font);
+    testGolden(font);
+    testRandomTexts(font);
+    return checkResult();
+}